@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/* --- Shared benchmark helpers --- */
+
+static inline double Bench_Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// xorshift64*, good enough to generate keys without pulling rand() into the timed loops
+static inline uint64_t Bench_Rand(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+// keeps the compiler from discarding results computed in a benchmark loop
+static inline void Bench_Consume(uint64_t value) {
+    __asm__ volatile("" : : "r"(value) : "memory");
+}
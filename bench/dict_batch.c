@@ -0,0 +1,68 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* Lookups of random keys in tables from cache resident up to well past the LLC, one Dict_Get at a time vs
+ * Dict_GetMany. Once the table stops fitting in cache every Dict_Get stalls on its own miss, the batched version
+ * issues the prefetches for a whole batch first so the misses overlap. */
+
+int main(void) {
+    const size_t sizes[]  = {1 << 12, 1 << 16, 1 << 20, 1 << 23};
+    const size_t lookups  = 1 << 23;
+    uint64_t*    keys     = malloc(sizeof(uint64_t) * lookups);
+    uint64_t*    out_vals = malloc(sizeof(uint64_t) * lookups);
+
+    for (size_t ii = 0; ii < sizeof(sizes) / sizeof(sizes[0]); ii++) {
+        size_t    size        = sizes[ii];
+        uint64_t* stored_keys = malloc(sizeof(uint64_t) * size);
+        uint64_t  rng         = 0x9E3779B97F4A7C15ull;
+
+        Dict(uint64_t, uint64_t) dict;
+        assert(Dict_Init(&dict, 0));
+
+        for (size_t jj = 0; jj < size; jj++) {
+            stored_keys[jj] = Bench_Rand(&rng);
+            assert(Dict_Set(&dict, stored_keys[jj], jj));
+        }
+
+        // half hits, half misses
+        for (size_t jj = 0; jj < lookups; jj++) {
+            keys[jj] = jj % 2 ? stored_keys[Bench_Rand(&rng) % size] : Bench_Rand(&rng);
+        }
+
+        double   start = Bench_Now();
+        uint64_t found = 0;
+        for (size_t jj = 0; jj < lookups; jj++) {
+            found += Dict_Get(&dict, keys[jj], &out_vals[jj]);
+        }
+        double single = Bench_Now() - start;
+        Bench_Consume(found);
+
+        start = Bench_Now();
+        Bench_Consume(Dict_GetMany(&dict, keys, lookups, out_vals, NULL));
+        double batched = Bench_Now() - start;
+
+        printf(
+            "size=%-8zu (%6.1f MiB)  Dict_Get %6.1f Mlookup/s  Dict_GetMany %6.1f Mlookup/s  (%.2fx)\n",
+            size,
+            dict.capacity * (sizeof(uint64_t) * 2 + 1) / (1024.0 * 1024.0),
+            lookups / single / 1e6,
+            lookups / batched / 1e6,
+            single / batched);
+
+        free(stored_keys);
+        Dict_Uninit(&dict);
+    }
+
+    free(keys);
+    free(out_vals);
+    return 0;
+}
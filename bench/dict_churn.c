@@ -0,0 +1,64 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* Steady-state insert/erase: the live set is a sliding window of keys, every step inserts one key and removes the
+ * oldest. Capacity should settle and stay put while tombstones get recycled. */
+
+int main(void) {
+    const uint64_t live_sizes[] = {1000, 100000, 1000000};
+    const uint64_t steps        = 20000000;
+
+    for (size_t ii = 0; ii < sizeof(live_sizes) / sizeof(live_sizes[0]); ii++) {
+        uint64_t live = live_sizes[ii];
+
+        Dict(uint64_t, uint64_t) dict;
+        assert(Dict_Init(&dict, 0));
+
+        uint64_t  rng    = 0x9E3779B97F4A7C15ull;
+        uint64_t* window = malloc(sizeof(uint64_t) * live);
+
+        for (uint64_t jj = 0; jj < live; jj++) {
+            window[jj] = Bench_Rand(&rng);
+            assert(Dict_Set(&dict, window[jj], jj));
+        }
+
+        size_t start_capacity = dict.capacity;
+        size_t max_capacity   = dict.capacity;
+        double start          = Bench_Now();
+
+        for (uint64_t jj = 0; jj < steps; jj++) {
+            uint64_t* oldest = &window[jj % live];
+            Dict_Remove(&dict, *oldest);
+
+            *oldest = Bench_Rand(&rng);
+            Dict_Set(&dict, *oldest, jj);
+
+            max_capacity = CTL_MAX(max_capacity, dict.capacity);
+        }
+
+        double elapsed = Bench_Now() - start;
+
+        printf(
+            "live=%-8lu %6.1f Mop/s (insert+erase pairs)  capacity start=%zu max=%zu end=%zu tombstones=%zu\n",
+            live,
+            steps / elapsed / 1e6,
+            start_capacity,
+            max_capacity,
+            dict.capacity,
+            dict.tombstones);
+
+        free(window);
+        Dict_Uninit(&dict);
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* Hash flooding, an attacker who knows the hash function picks keys whose hashes share their group bits and tag so
+ * that every key lands on the same probe sequence. Against a dict with a fixed seed (the old unseeded hashes) each
+ * insert and lookup then walks every group the earlier keys filled and compares against every one of them, with
+ * Dict_Init's random seed the same keys spread out like any others. Random keys are the baseline. */
+
+// inverse of the murmur3 finalizer used by the integer hashes, turns a chosen hash into the key that has it under
+// seed 0
+static uint64_t Unhash64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0x9cb4b2f8129337db;
+    x ^= x >> 33;
+    x *= 0x4f74430c22a54005;
+    x ^= x >> 33;
+    return x;
+}
+
+// inserts then looks up every key, returns ns per operation
+static double Bench_Flood(uint64_t* keys, size_t count, bool seeded) {
+    Dict(uint64_t, uint64_t) dict;
+    assert(seeded ? Dict_Init(&dict, 0) : Dict_InitWithSeed(&dict, 0, 0));
+
+    double start = Bench_Now();
+    for (size_t ii = 0; ii < count; ii++) {
+        assert(Dict_Set(&dict, keys[ii], ii));
+    }
+
+    uint64_t found = 0;
+    for (size_t ii = 0; ii < count; ii++) {
+        found += *Dict_GetPtr(&dict, keys[ii]);
+    }
+    double elapsed = Bench_Now() - start;
+    Bench_Consume(found);
+
+    Dict_Uninit(&dict);
+    return elapsed / (2.0 * count) * 1e9;
+}
+
+int main(void) {
+    const size_t counts[] = {1 << 10, 1 << 12, 1 << 14};
+
+    printf("%-8s %14s %14s %14s\n", "keys", "random ns/op", "flood fixed", "flood seeded");
+
+    for (size_t ii = 0; ii < sizeof(counts) / sizeof(counts[0]); ii++) {
+        size_t    count  = counts[ii];
+        uint64_t* random = malloc(sizeof(uint64_t) * count);
+        uint64_t* flood  = malloc(sizeof(uint64_t) * count);
+        uint64_t  rng    = 0x9E3779B97F4A7C15ull;
+
+        for (size_t jj = 0; jj < count; jj++) {
+            random[jj] = Bench_Rand(&rng);
+            // the same top 24 bits (group index) and low 7 bits (tag) for every key, only the bits in between vary
+            flood[jj] = Unhash64(0xABCDEFull << 40 | (uint64_t)jj << 7 | 0x2A);
+        }
+
+        printf(
+            "%-8zu %14.1f %14.1f %14.1f\n",
+            count,
+            Bench_Flood(random, count, true),
+            Bench_Flood(flood, count, false),
+            Bench_Flood(flood, count, true));
+
+        free(random);
+        free(flood);
+    }
+
+    return 0;
+}
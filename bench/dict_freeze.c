@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* A dict built once and then only looked up, as the mutable dict vs Dict_Freeze's minimal perfect hash table. The
+ * frozen table needs no empty slots and no metadata, and a lookup is one hash, one displacement load and one key
+ * compare instead of a probe loop. Memory is the table (and displacement array) only, lookups are random hits. */
+
+int main(void) {
+    const size_t sizes[] = {1 << 12, 1 << 16, 1 << 20, 1 << 22};
+    const size_t lookups = 1 << 23;
+    uint64_t*    keys    = malloc(sizeof(uint64_t) * lookups);
+
+    for (size_t ii = 0; ii < sizeof(sizes) / sizeof(sizes[0]); ii++) {
+        size_t    size        = sizes[ii];
+        uint64_t* stored_keys = malloc(sizeof(uint64_t) * size);
+        uint64_t  rng         = 0x9E3779B97F4A7C15ull;
+
+        Dict(uint64_t, uint64_t) dict;
+        Dict_Frozen(uint64_t, uint64_t) frozen;
+        assert(Dict_Init(&dict, 0));
+
+        for (size_t jj = 0; jj < size; jj++) {
+            stored_keys[jj] = Bench_Rand(&rng);
+            assert(Dict_Set(&dict, stored_keys[jj], jj));
+        }
+
+        double start = Bench_Now();
+        assert(Dict_Freeze(&dict, &frozen));
+        double freeze_time = Bench_Now() - start;
+
+        for (size_t jj = 0; jj < lookups; jj++) {
+            keys[jj] = stored_keys[Bench_Rand(&rng) % size];
+        }
+
+        uint64_t sum = 0;
+        start        = Bench_Now();
+        for (size_t jj = 0; jj < lookups; jj++) {
+            sum += *Dict_GetPtr(&dict, keys[jj]);
+        }
+        double dict_time = Bench_Now() - start;
+
+        start = Bench_Now();
+        for (size_t jj = 0; jj < lookups; jj++) {
+            sum += *Dict_GetPtr(&frozen, keys[jj]);
+        }
+        double frozen_time = Bench_Now() - start;
+        Bench_Consume(sum);
+
+        size_t dict_bytes   = Dict_TableSize(&dict, dict.capacity);
+        size_t frozen_bytes = frozen.size * sizeof(uint64_t) * 2 + frozen.bucket_count * sizeof(uint32_t);
+
+        printf(
+            "size=%-8zu dict %7.1f MiB %6.1f Mlookup/s  frozen %7.1f MiB %6.1f Mlookup/s  (%.2fx)  freeze %.1f ms\n",
+            size,
+            dict_bytes / (1024.0 * 1024.0),
+            lookups / dict_time / 1e6,
+            frozen_bytes / (1024.0 * 1024.0),
+            lookups / frozen_time / 1e6,
+            dict_time / frozen_time,
+            freeze_time * 1e3);
+
+        free(stored_keys);
+        Dict_Uninit(&dict);
+        Dict_Uninit(&frozen);
+    }
+
+    free(keys);
+    return 0;
+}
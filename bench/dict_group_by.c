@@ -0,0 +1,132 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* A group by (SELECT key, SUM(val) ... GROUP BY key) over ROWS rows, one thread calling Dict_Upsert per row vs a
+ * Dict_Partitioned filled by 1 up to the core count threads, each aggregating its share of the rows into its own
+ * per-partition dicts, then merging the partitions (each thread merging every thread_count'th partition). The merge
+ * reuses the hashes from the aggregation. Usage: dict_group_by [max threads] */
+
+#define ROWS       (1 << 23)
+#define PARTITIONS 64
+
+typedef struct {
+    Dict_Partitioned(uint64_t, uint64_t) * parts;
+    const uint64_t*    keys;
+    size_t             thread_index;
+    size_t             thread_count;
+    pthread_barrier_t* barrier;
+    double             merge_start;
+} Bench_Worker;
+
+static void Sum(uint64_t* dst_val, uint64_t* src_val, void* ctx) {
+    (void)ctx;
+    *dst_val += *src_val;
+}
+
+static void* Bench_Aggregate(void* arg) {
+    Bench_Worker* worker = arg;
+    size_t        begin  = ROWS / worker->thread_count * worker->thread_index;
+    size_t        end    = ROWS / worker->thread_count * (worker->thread_index + 1);
+
+    for (size_t row = begin; row < end; row++) {
+        *Dict_Upsert(worker->parts, worker->thread_index, worker->keys[row], NULL) += row;
+    }
+
+    // every worker has to be done before any partition can be merged
+    pthread_barrier_wait(worker->barrier);
+    worker->merge_start = Bench_Now();
+
+    for (size_t partition = worker->thread_index; partition < PARTITIONS; partition += worker->thread_count) {
+        assert(Dict_MergePartition(worker->parts, partition, Sum, NULL));
+    }
+
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    long           cores       = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t         max_threads = argc > 1 ? (size_t)atol(argv[1]) : (size_t)(cores > 0 ? cores : 1);
+    const uint64_t groups[]    = {1 << 12, 1 << 16, 1 << 20};
+    uint64_t*      keys        = malloc(sizeof(uint64_t) * ROWS);
+
+    printf("%-8s %-8s %14s %10s %10s\n", "groups", "threads", "Mrow/s", "speedup", "merge ms");
+
+    for (size_t ii = 0; ii < sizeof(groups) / sizeof(groups[0]); ii++) {
+        uint64_t rng = 0x9E3779B97F4A7C15ull;
+        for (size_t row = 0; row < ROWS; row++) {
+            keys[row] = Dict_Mix64(Bench_Rand(&rng) % groups[ii]);
+        }
+
+        Dict(uint64_t, uint64_t) single;
+        assert(Dict_Init(&single, 0));
+
+        double start = Bench_Now();
+        for (size_t row = 0; row < ROWS; row++) {
+            *Dict_Upsert(&single, keys[row], NULL) += row;
+        }
+        double single_time = Bench_Now() - start;
+        printf("%-8lu %-8s %14.1f\n", (unsigned long)groups[ii], "single", ROWS / single_time / 1e6);
+
+        // 1, 2, 4, ... threads, ending at exactly max_threads
+        size_t next_threads;
+        for (size_t threads = 1; threads <= max_threads; threads = next_threads) {
+            next_threads = threads == max_threads ? threads + 1 : CTL_MIN(threads * 2, max_threads);
+
+            Dict_Partitioned(uint64_t, uint64_t) parts;
+            pthread_t*        thread_ids = malloc(sizeof(pthread_t) * threads);
+            Bench_Worker*     workers    = malloc(sizeof(Bench_Worker) * threads);
+            pthread_barrier_t barrier;
+            assert(Dict_InitPartitioned(&parts, threads, PARTITIONS, 0));
+            pthread_barrier_init(&barrier, NULL, threads);
+
+            start = Bench_Now();
+            for (size_t tt = 0; tt < threads; tt++) {
+                workers[tt] = (Bench_Worker){&parts, keys, tt, threads, &barrier, 0.0};
+                assert(pthread_create(&thread_ids[tt], NULL, Bench_Aggregate, &workers[tt]) == 0);
+            }
+
+            for (size_t tt = 0; tt < threads; tt++) {
+                pthread_join(thread_ids[tt], NULL);
+            }
+            double end = Bench_Now();
+
+            // the result has to match the single threaded aggregation
+            size_t size = 0;
+            for (size_t partition = 0; partition < PARTITIONS; partition++) {
+                size += parts.partition[partition].size;
+            }
+
+            uint64_t sum = 0;
+            assert(size == single.size && Dict_Get(&parts, keys[0], &sum) && sum == *Dict_GetPtr(&single, keys[0]));
+
+            printf(
+                "%-8lu %-8zu %14.1f %9.2fx %10.1f\n",
+                (unsigned long)groups[ii],
+                threads,
+                ROWS / (end - start) / 1e6,
+                single_time / (end - start),
+                (end - workers[0].merge_start) * 1e3);
+
+            pthread_barrier_destroy(&barrier);
+            free(thread_ids);
+            free(workers);
+            Dict_Uninit(&parts);
+        }
+
+        Dict_Uninit(&single);
+    }
+
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* Time to double a 10M entry string keyed dict. The baseline re-inserts every entry through Dict_Set into a new
+ * table (what Dict_Grow used to do), Dict_GrowTo places entries directly, and with Dict_CacheHash it doesn't hash
+ * the keys either. */
+
+typedef char* str_cached;
+
+#define Dict_KeyType       char*
+#define Dict_KeyType_Alias str
+#define Dict_ValueType     uint64_t
+#include "containers/dict.h"
+
+#define Dict_KeyType   str_cached
+#define Dict_ValueType uint64_t
+#define Dict_CacheHash
+#include "containers/dict.h"
+
+#define COUNT     10000000
+#define KEY_BYTES 32
+
+// fills a dict right up to COUNT entries in a table that doubles on the next growth
+#define FILL(dict, keys)                                \
+    do {                                                \
+        assert(Dict_Init((dict), 0));                   \
+        assert(Dict_Reserve((dict), COUNT));            \
+        for (size_t _ii = 0; _ii < COUNT; _ii++) {      \
+            assert(Dict_Set((dict), (keys)[_ii], _ii)); \
+        }                                               \
+    } while (0)
+
+int main(void) {
+    char*  arena = malloc((size_t)COUNT * KEY_BYTES);
+    char** keys  = malloc(sizeof(char*) * COUNT);
+    for (size_t ii = 0; ii < COUNT; ii++) {
+        keys[ii] = arena + ii * KEY_BYTES;
+        snprintf(keys[ii], KEY_BYTES, "user/%zu/session/%zu", ii * 7919 % 100003, ii);
+    }
+
+    Dict(str, uint64_t) dict;
+    Dict(str_cached, uint64_t) dict_cached;
+    double start;
+
+    printf("doubling a %d entry char* dict\n", COUNT);
+
+    // baseline, reinsert everything through Dict_Set
+    FILL(&dict, keys);
+    {
+        size_t capacity = dict.capacity;
+        start           = Bench_Now();
+
+        Dict(str, uint64_t) dict_new;
+        assert(Dict_Init(&dict_new, 2 * dict.capacity - 1));
+        for (size_t group_index = 0; group_index < dict.capacity / 16; group_index++) {
+            for (int slot_index = 0; slot_index < 16; slot_index++) {
+                if (dict.metadata_group[group_index].slot[slot_index].u8 & 0x80) {
+                    Dict_Set(
+                        &dict_new,
+                        dict.key_group[group_index].key[slot_index],
+                        dict.value_group[group_index].val[slot_index]);
+                }
+            }
+        }
+        Dict_Uninit(&dict);
+        dict = dict_new;
+
+        printf(
+            "  Dict_Set reinsert       %7.1f ms  (%zu -> %zu slots)\n",
+            (Bench_Now() - start) * 1e3,
+            capacity,
+            dict.capacity);
+    }
+    Dict_Uninit(&dict);
+
+    FILL(&dict, keys);
+    start = Bench_Now();
+    assert(Dict_Grow(&dict));
+    printf("  Dict_Grow               %7.1f ms\n", (Bench_Now() - start) * 1e3);
+    Dict_Uninit(&dict);
+
+    FILL(&dict_cached, keys);
+    start = Bench_Now();
+    assert(Dict_Grow(&dict_cached));
+    printf("  Dict_Grow (cached hash) %7.1f ms\n", (Bench_Now() - start) * 1e3);
+    Dict_Uninit(&dict_cached);
+
+    free(keys);
+    free(arena);
+    return 0;
+}
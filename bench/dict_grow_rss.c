@@ -0,0 +1,86 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+/* Peak resident memory while filling a dict past a growth threshold, with the default grow (old and new tables
+ * both live) and with Dict_GrowInPlace (realloc and redistribute). Each run happens in its own child process so
+ * that the peak RSS reported for it is its own. */
+
+typedef uint64_t u64_in_place;
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+#define Dict_KeyType     u64_in_place
+#define Dict_ValueType   uint64_t
+#define Dict_GrowInPlace
+#include "containers/dict.h"
+
+// just past the growth threshold of a 2^24 slot table, the last grow is 2^24 -> 2^25 slots
+#define COUNT ((1 << 24) / 8 * 7 + 1)
+
+#define RUN(dict, elapsed, capacity)                          \
+    do {                                                      \
+        uint64_t _rng = 42;                                   \
+        double   _start = Bench_Now();                        \
+        assert(Dict_Init((dict), 0));                         \
+        for (size_t _ii = 0; _ii < COUNT; _ii++) {            \
+            assert(Dict_Set((dict), Bench_Rand(&_rng), _ii)); \
+        }                                                     \
+        (elapsed)  = Bench_Now() - _start;                    \
+        (capacity) = (dict)->capacity;                        \
+    } while (0)
+
+static void Report(const char* name, size_t capacity, double elapsed) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    double table_mib = capacity * (1 + 2 * sizeof(uint64_t)) / (1024.0 * 1024.0);
+    double peak_mib  = usage.ru_maxrss / 1024.0;
+    printf(
+        "  %-10s final table %6.1f MiB  peak RSS %6.1f MiB (%.2fx)  fill %.2f s\n",
+        name,
+        table_mib,
+        peak_mib,
+        peak_mib / table_mib,
+        elapsed);
+}
+
+int main(void) {
+    printf("%d uint64_t -> uint64_t inserts\n", COUNT);
+    fflush(stdout);
+
+    for (int mode = 0; mode < 2; mode++) {
+        pid_t pid = fork();
+        assert(pid >= 0);
+
+        if (pid == 0) {
+            double elapsed;
+            size_t capacity;
+
+            if (mode == 0) {
+                Dict(uint64_t, uint64_t) dict;
+                RUN(&dict, elapsed, capacity);
+                Report("default", capacity, elapsed);
+            } else {
+                Dict(u64_in_place, uint64_t) dict;
+                RUN(&dict, elapsed, capacity);
+                Report("in-place", capacity, elapsed);
+            }
+
+            exit(0);
+        }
+
+        waitpid(pid, NULL, 0);
+    }
+
+    return 0;
+}
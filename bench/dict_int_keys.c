@@ -0,0 +1,92 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* Lookups on dicts with 8, 16 and 32-bit integer keys, comparing a group's tag matches' keys all at once with SIMD
+ * compares (the default for 8 and 16-bit keys, Dict_SimdKeys for 32-bit ones) vs the tag path, which compares each
+ * tag match's key on its own. A custom Dict_CompareKey that's the same equality keeps a dict on the tag path. Half the
+ * lookups are hits and half misses, in a random order so the hit/miss branch can't be predicted. */
+
+#define LOOKUPS (1 << 23)
+
+#define Dict_KeyType   uint8_t
+#define Dict_ValueType uint32_t
+#include "containers/dict.h"
+
+#define Dict_KeyType   uint16_t
+#define Dict_ValueType uint32_t
+#include "containers/dict.h"
+
+#define Dict_KeyType   uint32_t
+#define Dict_ValueType uint32_t
+#define Dict_SimdKeys
+#include "containers/dict.h"
+
+typedef uint8_t  tag_u8;
+typedef uint16_t tag_u16;
+typedef uint32_t tag_u32;
+
+#define Dict_KeyType            tag_u8
+#define Dict_ValueType          uint32_t
+#define Dict_CompareKey(k1, k2) ((k1) == (k2))
+#include "containers/dict.h"
+
+#define Dict_KeyType            tag_u16
+#define Dict_ValueType          uint32_t
+#define Dict_CompareKey(k1, k2) ((k1) == (k2))
+#include "containers/dict.h"
+
+#define Dict_KeyType            tag_u32
+#define Dict_ValueType          uint32_t
+#define Dict_CompareKey(k1, k2) ((k1) == (k2))
+#include "containers/dict.h"
+
+// fills the dict with the even keys below 2 * size, then times LOOKUPS lookups of random keys below 2 * size (the odd
+// ones miss), returns Mlookup/s
+#define Bench_IntKeys(Tkey, Tkey_alias, size, rate)                                        \
+    do {                                                                                   \
+        Dict(Tkey_alias, uint32_t) dict;                                                   \
+        assert(Dict_Init(&dict, 0));                                                       \
+        for (uint32_t ii = 0; ii < (size); ii++) {                                         \
+            assert(Dict_Set(&dict, (Tkey)(ii * 2), ii));                                   \
+        }                                                                                  \
+                                                                                           \
+        uint64_t rng   = 0x9E3779B97F4A7C15ull;                                            \
+        uint64_t sum   = 0;                                                                \
+        double   start = Bench_Now();                                                      \
+        for (size_t ii = 0; ii < LOOKUPS; ii++) {                                          \
+            uint32_t* found = Dict_GetPtr(&dict, (Tkey)(Bench_Rand(&rng) % ((size) * 2))); \
+            sum += found != NULL ? *found : 1;                                             \
+        }                                                                                  \
+        rate = LOOKUPS / (Bench_Now() - start) / 1e6;                                      \
+                                                                                           \
+        Bench_Consume(sum);                                                                \
+        Dict_Uninit(&dict);                                                                \
+    } while (0)
+
+int main(void) {
+    const uint32_t sizes[] = {1 << 10, 1 << 14, 1 << 18, 1 << 22};
+
+    printf("%-9s %-8s %14s %14s %8s\n", "key", "size", "tag Mlookup/s", "simd Mlookup/s", "speedup");
+
+    double tag_rate, simd_rate;
+    Bench_IntKeys(uint8_t, tag_u8, 64, tag_rate);
+    Bench_IntKeys(uint8_t, uint8_t, 64, simd_rate);
+    printf("%-9s %-8d %14.1f %14.1f %7.2fx\n", "uint8_t", 64, tag_rate, simd_rate, simd_rate / tag_rate);
+
+    Bench_IntKeys(uint16_t, tag_u16, 1 << 14, tag_rate);
+    Bench_IntKeys(uint16_t, uint16_t, 1 << 14, simd_rate);
+    printf("%-9s %-8d %14.1f %14.1f %7.2fx\n", "uint16_t", 1 << 14, tag_rate, simd_rate, simd_rate / tag_rate);
+
+    for (size_t size = 0; size < sizeof(sizes) / sizeof(sizes[0]); size++) {
+        Bench_IntKeys(uint32_t, tag_u32, sizes[size], tag_rate);
+        Bench_IntKeys(uint32_t, uint32_t, sizes[size], simd_rate);
+        printf("%-9s %-8u %14.1f %14.1f %7.2fx\n", "uint32_t", sizes[size], tag_rate, simd_rate, simd_rate / tag_rate);
+    }
+
+    return 0;
+}
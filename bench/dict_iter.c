@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* Full-table iteration, summing every key and value. The Dict_Enumerate* pair needs one pass for keys and another
+ * for values and recovers its position from a pointer on every call, Dict_ForEach is a single cursor pass. The
+ * sparse table is the dense one after removing 90% of its entries, where skipping empty groups matters. */
+
+static bool Remove90(uint64_t* key, uint64_t* val, void* ctx) {
+    (void)key;
+    (void)ctx;
+    return *val % 10 != 0;
+}
+
+int main(void) {
+    const size_t count  = (1 << 21) / 8 * 7;
+    const int    rounds = 20;
+
+    Dict(uint64_t, uint64_t) dict;
+    assert(Dict_Init(&dict, 0));
+
+    uint64_t rng = 42;
+    for (size_t ii = 0; ii < count; ii++) {
+        assert(Dict_Set(&dict, Bench_Rand(&rng), ii));
+    }
+
+    for (int sparse = 0; sparse < 2; sparse++) {
+        if (sparse) {
+            Dict_RemoveIf(&dict, Remove90, NULL);
+        }
+
+        uint64_t sum   = 0;
+        double   start = Bench_Now();
+        for (int rr = 0; rr < rounds; rr++) {
+            for (uint64_t* key = Dict_EnumerateKeys(&dict, NULL); key != NULL; key = Dict_EnumerateKeys(&dict, key)) {
+                sum += *key;
+            }
+
+            for (uint64_t* val = Dict_EnumerateValues(&dict, NULL); val != NULL;
+                 val           = Dict_EnumerateValues(&dict, val)) {
+                sum += *val;
+            }
+        }
+        double enumerate = Bench_Now() - start;
+        Bench_Consume(sum);
+
+        sum   = 0;
+        start = Bench_Now();
+        for (int rr = 0; rr < rounds; rr++) {
+            Dict_ForEach(&dict, key, val) {
+                sum += *key + *val;
+            }
+        }
+        double for_each = Bench_Now() - start;
+        Bench_Consume(sum);
+
+        double entries = (double)dict.size * rounds;
+        printf(
+            "%-6s %7zu entries in %7zu slots  Dict_Enumerate* %6.1f Mentry/s  Dict_ForEach %6.1f Mentry/s  (%.2fx)\n",
+            sparse ? "sparse" : "dense",
+            dict.size,
+            dict.capacity,
+            entries / enumerate / 1e6,
+            entries / for_each / 1e6,
+            enumerate / for_each);
+    }
+
+    Dict_Uninit(&dict);
+    return 0;
+}
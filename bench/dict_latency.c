@@ -0,0 +1,82 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* Per-operation latency while inserting into a dict from empty, with the default stop-the-world grow and with
+ * Dict_Incremental. Every insert is timed individually, the tail is where the grows show up. With Dict_Incremental
+ * the worst case left is freeing the old table once its migration finishes (returning it to the OS isn't free
+ * for large tables). */
+
+typedef uint64_t u64_incremental;
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+#define Dict_KeyType     u64_incremental
+#define Dict_ValueType   uint64_t
+#define Dict_Incremental 1
+#include "containers/dict.h"
+
+#define COUNT (1 << 23)
+
+// interleaves an insert of a new key with a lookup of an existing one, timing each pair
+#define RUN(dict, latencies)                                                                  \
+    do {                                                                                      \
+        uint64_t _rng = 42, _out;                                                             \
+        assert(Dict_Init((dict), 0));                                                         \
+        for (size_t _ii = 0; _ii < COUNT; _ii++) {                                            \
+            uint64_t _key   = Bench_Rand(&_rng);                                              \
+            double   _start = Bench_Now();                                                    \
+            Dict_Set((dict), _key, _ii);                                                      \
+            Bench_Consume(Dict_Get((dict), _key, &_out));                                     \
+            (latencies)[_ii] = (Bench_Now() - _start) * 1e9;                                  \
+        }                                                                                     \
+        Dict_Uninit((dict));                                                                  \
+    } while (0)
+
+static int Compare(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void Print(const char* name, double* latencies) {
+    double total = 0;
+    for (size_t ii = 0; ii < COUNT; ii++) {
+        total += latencies[ii];
+    }
+
+    qsort(latencies, COUNT, sizeof(double), Compare);
+    printf(
+        "  %-12s mean %6.0f  p50 %6.0f  p99 %6.0f  p99.9 %6.0f  p99.99 %8.0f  max %10.0f ns  (total %.2f s)\n",
+        name,
+        total / COUNT,
+        latencies[(size_t)(COUNT * 0.5)],
+        latencies[(size_t)(COUNT * 0.99)],
+        latencies[(size_t)(COUNT * 0.999)],
+        latencies[(size_t)(COUNT * 0.9999)],
+        latencies[COUNT - 1],
+        total * 1e-9);
+}
+
+int main(void) {
+    double* latencies = malloc(sizeof(double) * COUNT);
+
+    Dict(uint64_t, uint64_t) dict;
+    Dict(u64_incremental, uint64_t) dict_incremental;
+
+    printf("%d inserts (Dict_Set + Dict_Get of the new key) into an empty dict\n", COUNT);
+
+    RUN(&dict, latencies);
+    Print("stop-world", latencies);
+
+    RUN(&dict_incremental, latencies);
+    Print("incremental", latencies);
+
+    free(latencies);
+    return 0;
+}
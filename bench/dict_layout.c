@@ -0,0 +1,117 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+typedef struct {
+    uint64_t word[8];
+} payload;
+
+#define Dict_KeyType       uint64_t
+#define Dict_KeyType_Alias u64_split
+#define Dict_ValueType     uint64_t
+#include "containers/dict.h"
+
+#define Dict_KeyType       uint64_t
+#define Dict_KeyType_Alias u64_interleaved
+#define Dict_ValueType     uint64_t
+#define Dict_Layout        Dict_Layout_Interleaved
+#include "containers/dict.h"
+
+#define Dict_KeyType       uint32_t
+#define Dict_KeyType_Alias u32_split
+#define Dict_ValueType     uint32_t
+#include "containers/dict.h"
+
+#define Dict_KeyType       uint32_t
+#define Dict_KeyType_Alias u32_interleaved
+#define Dict_ValueType     uint32_t
+#define Dict_Layout        Dict_Layout_Interleaved
+#include "containers/dict.h"
+
+#define Dict_KeyType       uint64_t
+#define Dict_KeyType_Alias u64_split
+#define Dict_ValueType     payload
+#include "containers/dict.h"
+
+#define Dict_KeyType       uint64_t
+#define Dict_KeyType_Alias u64_interleaved
+#define Dict_ValueType     payload
+#define Dict_Layout        Dict_Layout_Interleaved
+#include "containers/dict.h"
+
+/* Cold lookups, random hits in a table far bigger than the LLC, with the split layout vs the interleaved one. A
+ * split hit touches the metadata, the key's line and then the value's line in a different part of the block, an
+ * interleaved hit finds the value next to the key. The gap closes as values get big enough that the key and its
+ * value no longer share a line anyway. */
+
+#define LOOKUPS (1 << 23)
+
+// fills a dict of each layout with the same keys and times the same lookups in both
+#define Bench_Layout(name, Tkey, Tval, Tsplit, Tinterleaved, size, read)                                   \
+    static void Bench_Layout_##name(void) {                                                                \
+        Tkey*    stored_keys = malloc(sizeof(Tkey) * (size));                                              \
+        Tkey*    keys        = malloc(sizeof(Tkey) * LOOKUPS);                                             \
+        uint64_t rng         = 0x9E3779B97F4A7C15ull;                                                      \
+        Tval     val         = {0};                                                                        \
+                                                                                                           \
+        Dict(Tsplit, Tval) split;                                                                          \
+        Dict(Tinterleaved, Tval) interleaved;                                                              \
+        assert(Dict_Init(&split, 0));                                                                      \
+        assert(Dict_Init(&interleaved, 0));                                                                \
+                                                                                                           \
+        for (size_t ii = 0; ii < (size); ii++) {                                                           \
+            stored_keys[ii] = (Tkey)Bench_Rand(&rng);                                                      \
+            assert(Dict_Set(&split, stored_keys[ii], val));                                                \
+            assert(Dict_Set(&interleaved, stored_keys[ii], val));                                          \
+        }                                                                                                  \
+                                                                                                           \
+        for (size_t ii = 0; ii < LOOKUPS; ii++) {                                                          \
+            keys[ii] = stored_keys[Bench_Rand(&rng) % (size)];                                             \
+        }                                                                                                  \
+                                                                                                           \
+        double   start = Bench_Now();                                                                      \
+        uint64_t sum   = 0;                                                                                \
+        for (size_t ii = 0; ii < LOOKUPS; ii++) {                                                          \
+            Tval* found = Dict_GetPtr(&split, keys[ii]);                                                   \
+            sum += read;                                                                                   \
+        }                                                                                                  \
+        double split_time = Bench_Now() - start;                                                           \
+        Bench_Consume(sum);                                                                                \
+                                                                                                           \
+        start = Bench_Now();                                                                               \
+        for (size_t ii = 0; ii < LOOKUPS; ii++) {                                                          \
+            Tval* found = Dict_GetPtr(&interleaved, keys[ii]);                                             \
+            sum += read;                                                                                   \
+        }                                                                                                  \
+        double interleaved_time = Bench_Now() - start;                                                     \
+        Bench_Consume(sum);                                                                                \
+                                                                                                           \
+        printf(                                                                                            \
+            "%-12s size=%-8zu (%6.1f MiB)  split %6.1f Mlookup/s  interleaved %6.1f Mlookup/s  (%.2fx)\n", \
+            #name,                                                                                         \
+            (size_t)(size),                                                                                \
+            split.capacity * (sizeof(Tkey) + sizeof(Tval) + 1) / (1024.0 * 1024.0),                        \
+            LOOKUPS / split_time / 1e6,                                                                    \
+            LOOKUPS / interleaved_time / 1e6,                                                              \
+            split_time / interleaved_time);                                                                \
+                                                                                                           \
+        free(stored_keys);                                                                                 \
+        free(keys);                                                                                        \
+        Dict_Uninit(&split);                                                                               \
+        Dict_Uninit(&interleaved);                                                                         \
+    }
+
+Bench_Layout(u64_u64, uint64_t, uint64_t, u64_split, u64_interleaved, 1 << 23, *found)
+Bench_Layout(u32_u32, uint32_t, uint32_t, u32_split, u32_interleaved, 1 << 23, *found)
+Bench_Layout(u64_payload, uint64_t, payload, u64_split, u64_interleaved, 1 << 21, found->word[0])
+
+int main(void) {
+    Bench_Layout_u64_u64();
+    Bench_Layout_u32_u32();
+    Bench_Layout_u64_payload();
+    return 0;
+}
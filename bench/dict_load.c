@@ -0,0 +1,128 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* Memory vs lookup latency across max load factors. Memory is the average bytes per entry while growing a table
+ * from 64K to 8M entries (sampled every 1/8th of the way between doublings), latency is measured on a 2^22 slot
+ * table filled right up to its growth threshold, which is the worst case for each setting. */
+
+typedef uint64_t u64_load_1_2;
+typedef uint64_t u64_load_3_4;
+typedef uint64_t u64_load_7_8;
+typedef uint64_t u64_load_15_16;
+
+#define Dict_KeyType           u64_load_1_2
+#define Dict_ValueType         uint64_t
+#define Dict_MaxLoad(capacity) ((capacity) / 2)
+#include "containers/dict.h"
+
+#define Dict_KeyType           u64_load_3_4
+#define Dict_ValueType         uint64_t
+#define Dict_MaxLoad(capacity) ((capacity) / 4 * 3)
+#include "containers/dict.h"
+
+#define Dict_KeyType           u64_load_7_8
+#define Dict_ValueType         uint64_t
+#define Dict_MaxLoad(capacity) ((capacity) / 8 * 7)
+#include "containers/dict.h"
+
+#define Dict_KeyType           u64_load_15_16
+#define Dict_ValueType         uint64_t
+#define Dict_MaxLoad(capacity) ((capacity) / 16 * 15)
+#include "containers/dict.h"
+
+#define GROW_COUNT  (1 << 23)
+#define TABLE_SLOTS (1 << 22)
+
+typedef struct {
+    double bytes_per_entry;
+    double hit_ns;
+    double miss_ns;
+} Result;
+
+// bytes/entry for the metadata, key and value arrays at the current size
+#define BYTES_PER_ENTRY(dict) \
+    ((double)(dict)->capacity * (1 + sizeof(uint64_t) + sizeof(uint64_t)) / (double)(dict)->size)
+
+#define RUN(dict, keys, misses, max_load, result)                                                     \
+    do {                                                                                              \
+        double _bytes = 0;                                                                            \
+        size_t _samples = 0, _next_sample = 1 << 16;                                                  \
+        assert(Dict_Init((dict), 0));                                                                 \
+        for (size_t _ii = 0; _ii < GROW_COUNT; _ii++) {                                               \
+            assert(Dict_Set((dict), (keys)[_ii], _ii));                                               \
+            if (_ii + 1 == _next_sample) {                                                            \
+                _bytes += BYTES_PER_ENTRY(dict);                                                      \
+                _samples += 1;                                                                        \
+                _next_sample += CTL_NEXT_POW2(_next_sample + 1) / 16;                                 \
+            }                                                                                         \
+        }                                                                                             \
+        (result).bytes_per_entry = _bytes / (double)_samples;                                         \
+        Dict_Uninit((dict));                                                                          \
+        size_t _count = (max_load);                                                                   \
+        assert(Dict_Init((dict), TABLE_SLOTS - 1));                                                   \
+        for (size_t _ii = 0; _ii < _count; _ii++) {                                                   \
+            assert(Dict_Set((dict), (keys)[_ii], _ii));                                               \
+        }                                                                                             \
+        assert((dict)->capacity == TABLE_SLOTS);                                                      \
+        uint64_t _out, _found = 0;                                                                    \
+        double   _start = Bench_Now();                                                                \
+        for (size_t _ii = 0; _ii < _count; _ii++) {                                                   \
+            _found += Dict_Get((dict), (keys)[(_ii * 0x9E3779B1) % _count], &_out);                   \
+        }                                                                                             \
+        (result).hit_ns = (Bench_Now() - _start) * 1e9 / (double)_count;                              \
+        _start          = Bench_Now();                                                                \
+        for (size_t _ii = 0; _ii < _count; _ii++) {                                                   \
+            _found += Dict_Get((dict), (misses)[_ii], &_out);                                         \
+        }                                                                                             \
+        (result).miss_ns = (Bench_Now() - _start) * 1e9 / (double)_count;                             \
+        Bench_Consume(_found);                                                                        \
+        Dict_Uninit((dict));                                                                          \
+    } while (0)
+
+static void Print(const char* max_load, size_t count, Result result) {
+    printf(
+        "  %-6s %6.2f bytes/entry   at threshold (%7zu entries): hit %5.1f ns  miss %5.1f ns\n",
+        max_load,
+        result.bytes_per_entry,
+        count,
+        result.hit_ns,
+        result.miss_ns);
+}
+
+int main(void) {
+    uint64_t* keys   = malloc(sizeof(uint64_t) * GROW_COUNT);
+    uint64_t* misses = malloc(sizeof(uint64_t) * GROW_COUNT);
+    uint64_t  rng    = 42;
+
+    for (size_t ii = 0; ii < GROW_COUNT; ii++) {
+        keys[ii]   = Bench_Rand(&rng);
+        misses[ii] = Bench_Rand(&rng);
+    }
+
+    Dict(u64_load_1_2, uint64_t) load_1_2;
+    Dict(u64_load_3_4, uint64_t) load_3_4;
+    Dict(u64_load_7_8, uint64_t) load_7_8;
+    Dict(u64_load_15_16, uint64_t) load_15_16;
+    Result result;
+
+    printf("uint64_t -> uint64_t, 17 bytes of storage per slot\n");
+
+    RUN(&load_1_2, keys, misses, TABLE_SLOTS / 2, result);
+    Print("1/2", TABLE_SLOTS / 2, result);
+    RUN(&load_3_4, keys, misses, TABLE_SLOTS / 4 * 3, result);
+    Print("3/4", TABLE_SLOTS / 4 * 3, result);
+    RUN(&load_7_8, keys, misses, TABLE_SLOTS / 8 * 7, result);
+    Print("7/8", TABLE_SLOTS / 8 * 7, result);
+    RUN(&load_15_16, keys, misses, TABLE_SLOTS / 16 * 15, result);
+    Print("15/16", TABLE_SLOTS / 16 * 15, result);
+
+    free(keys);
+    free(misses);
+
+    return 0;
+}
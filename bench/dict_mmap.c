@@ -0,0 +1,90 @@
+#include <assert.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#define Dict_Mappable
+#include "containers/dict.h"
+
+/* Cold start, rebuilding a dict with Dict_Set vs opening one that was saved with Dict_MapFile. Opening the mapping
+ * doesn't touch the table, its cost shows up as page faults in the first lookups instead, so those are timed too
+ * and compared against the same lookups once the pages are in. The file is dropped from the page cache (best effort,
+ * posix_fadvise) before it's mapped so the first pass reads it back from disk. Usage: dict_mmap [path] */
+
+#define COUNT   (1 << 22)
+#define LOOKUPS (1 << 20)
+
+// times LOOKUPS lookups of random stored keys, returns ns per lookup
+static double Bench_Lookups(Dict(uint64_t, uint64_t) * dict, uint64_t* keys) {
+    uint64_t rng   = 0x2545F4914F6CDD1Dull;
+    uint64_t found = 0;
+
+    double start = Bench_Now();
+    for (size_t ii = 0; ii < LOOKUPS; ii++) {
+        found += *Dict_GetPtr(dict, keys[Bench_Rand(&rng) % COUNT]);
+    }
+    double elapsed = Bench_Now() - start;
+
+    Bench_Consume(found);
+    return elapsed / LOOKUPS * 1e9;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "/tmp/ctl_dict_mmap_bench.bin";
+    uint64_t*   keys = malloc(sizeof(uint64_t) * COUNT);
+    uint64_t    rng  = 0x9E3779B97F4A7C15ull;
+
+    for (size_t ii = 0; ii < COUNT; ii++) {
+        keys[ii] = Bench_Rand(&rng);
+    }
+
+    Dict(uint64_t, uint64_t) built;
+    double start = Bench_Now();
+    assert(Dict_Init(&built, 0));
+    for (size_t ii = 0; ii < COUNT; ii++) {
+        assert(Dict_Set(&built, keys[ii], ii));
+    }
+    double build_time = Bench_Now() - start;
+
+    start = Bench_Now();
+    assert(Dict_Save(&built, path));
+    double save_time = Bench_Now() - start;
+
+    int fd = open(path, O_RDONLY);
+    assert(fd >= 0);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+
+    Dict(uint64_t, uint64_t) mapped;
+    start = Bench_Now();
+    assert(Dict_MapFile(&mapped, path));
+    double map_time = Bench_Now() - start;
+
+    double cold_lookup  = Bench_Lookups(&mapped, keys);
+    double warm_lookup  = Bench_Lookups(&mapped, keys);
+    double built_lookup = Bench_Lookups(&built, keys);
+
+    printf("%d entries, %.1f MiB table\n", COUNT, mapped.mapping_size / (1024.0 * 1024.0));
+    printf("rebuild with Dict_Set  %8.1f ms\n", build_time * 1e3);
+    printf("Dict_Save              %8.1f ms\n", save_time * 1e3);
+    printf("Dict_MapFile           %8.3f ms\n", map_time * 1e3);
+    printf(
+        "lookups, ns each       mapped cold %.1f  mapped warm %.1f  built %.1f\n",
+        cold_lookup,
+        warm_lookup,
+        built_lookup);
+
+    Dict_Uninit(&built);
+    Dict_Uninit(&mapped);
+    remove(path);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+#define Dict_KeyType       uint64_t
+#define Dict_KeyType_Alias u64_ordered
+#define Dict_ValueType     uint64_t
+#define Dict_Layout        Dict_Layout_Ordered
+#include "containers/dict.h"
+
+/* The default split layout vs Dict_Layout_Ordered, iterating with Dict_ForEach, random lookup hits, and the size of
+ * the table. Iterating the split layout sweeps every group of the table, the ordered one scans its entry array,
+ * which matters most right after a grow (the table is under half full) and after removing most of the entries (the
+ * ordered dict keeps holes too, but skips them a 64-entry bitmap word at a time). Lookups pay for the ordered
+ * layout's extra load of an entry's index before its key. */
+
+#define ROUNDS  20
+#define LOOKUPS (1 << 22)
+
+static bool Remove90(uint64_t* key, uint64_t* val, void* ctx) {
+    (void)key;
+    (void)ctx;
+    return *val % 10 != 0;
+}
+
+// times ROUNDS passes of Dict_ForEach and LOOKUPS lookups of stored keys, in Mentry/s and Mlookup/s
+#define Bench_Ordered(dict, keys, count, iter_rate, lookup_rate)                          \
+    do {                                                                                  \
+        uint64_t sum   = 0;                                                               \
+        double   start = Bench_Now();                                                     \
+        for (int rr = 0; rr < ROUNDS; rr++) {                                             \
+            Dict_ForEach(dict, key, val) {                                                \
+                sum += *key + *val;                                                       \
+            }                                                                             \
+        }                                                                                 \
+        iter_rate = (double)(dict)->size * ROUNDS / (Bench_Now() - start) / 1e6;          \
+                                                                                          \
+        uint64_t lookup_rng = 0x2545F4914F6CDD1Dull;                                      \
+        start               = Bench_Now();                                                \
+        for (size_t ii = 0; ii < LOOKUPS; ii++) {                                         \
+            uint64_t* found = Dict_GetPtr(dict, keys[Bench_Rand(&lookup_rng) % (count)]); \
+            sum += found != NULL ? *found : 0;                                            \
+        }                                                                                 \
+        lookup_rate = LOOKUPS / (Bench_Now() - start) / 1e6;                              \
+        Bench_Consume(sum);                                                               \
+    } while (0)
+
+int main(void) {
+    // just over the max load of 2^20 slots (so the table has just grown to 2^21), and right at the max load of 2^21
+    const size_t counts[] = {(1 << 20) / 8 * 7 + 1, (1 << 21) / 8 * 7};
+    const char*  names[]  = {"grown", "full", "sparse"};
+
+    printf("%-7s %8s %8s  %-28s %-28s %s\n", "table", "entries", "slots", "split", "ordered", "ordered/split");
+
+    for (int scenario = 0; scenario < 3; scenario++) {
+        size_t    count = counts[scenario == 0 ? 0 : 1];
+        uint64_t* keys  = malloc(sizeof(uint64_t) * count);
+        uint64_t  rng   = 42;
+
+        Dict(uint64_t, uint64_t) split;
+        Dict(u64_ordered, uint64_t) ordered;
+        assert(Dict_Init(&split, 0));
+        assert(Dict_Init(&ordered, 0));
+
+        for (size_t ii = 0; ii < count; ii++) {
+            keys[ii] = Bench_Rand(&rng);
+            assert(Dict_Set(&split, keys[ii], ii));
+            assert(Dict_Set(&ordered, keys[ii], ii));
+        }
+
+        if (scenario == 2) {
+            Dict_RemoveIf(&split, Remove90, NULL);
+            Dict_RemoveIf(&ordered, Remove90, NULL);
+        }
+
+        double split_iter, split_lookup, ordered_iter, ordered_lookup;
+        Bench_Ordered(&split, keys, count, split_iter, split_lookup);
+        Bench_Ordered(&ordered, keys, count, ordered_iter, ordered_lookup);
+
+        double split_mib   = Dict_TableSize(&split, split.capacity) / (1024.0 * 1024.0);
+        double ordered_mib = Dict_TableSize(&ordered, ordered.capacity) / (1024.0 * 1024.0);
+
+        printf(
+            "%-7s %8zu %8zu  %5.1f MiB %6.1f/%5.1f M/s  %5.1f MiB %6.1f/%5.1f M/s  iter %.2fx lookup %.2fx mem %.2fx\n",
+            names[scenario],
+            split.size,
+            split.capacity,
+            split_mib,
+            split_iter,
+            split_lookup,
+            ordered_mib,
+            ordered_iter,
+            ordered_lookup,
+            ordered_iter / split_iter,
+            ordered_lookup / split_lookup,
+            ordered_mib / split_mib);
+
+        free(keys);
+        Dict_Uninit(&split);
+        Dict_Uninit(&ordered);
+    }
+
+    printf("(M/s columns are Dict_ForEach Mentry/s / random hit Mlookup/s)\n");
+    return 0;
+}
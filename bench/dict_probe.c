@@ -0,0 +1,143 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* Probe lengths (groups visited) for each probing policy over sequential, strided and random keys. The tables are
+ * filled right up to their growth threshold, which is where clustering hurts the most. */
+
+typedef uint64_t u64_linear;
+typedef uint64_t u64_triangular;
+typedef uint64_t u64_stride;
+
+#define Dict_KeyType   u64_linear
+#define Dict_ValueType uint64_t
+#define Dict_Probing   Dict_Probing_Linear
+#include "containers/dict.h"
+
+#define Dict_KeyType   u64_triangular
+#define Dict_ValueType uint64_t
+#define Dict_Probing   Dict_Probing_Triangular
+#include "containers/dict.h"
+
+#define Dict_KeyType   u64_stride
+#define Dict_ValueType uint64_t
+#define Dict_Probing   Dict_Probing_Stride
+#include "containers/dict.h"
+
+typedef struct {
+    double   hit_avg;
+    uint64_t hit_max;
+    double   miss_avg;
+    uint64_t miss_max;
+    double   miss_ns;
+} Result;
+
+// walks the probe sequence the same way Dict_Find does, counting the groups visited
+#define PROBE_LENGTH(dict, key, hit, length_out)                                                          \
+    do {                                                                                                  \
+        uint64_t   _hash = Dict_Hash((dict), (key));                                                      \
+        Dict_Probe _probe = Dict_ProbeStart((dict), _hash, (dict)->capacity / 16);                        \
+        size_t     _group, _slot;                                                                         \
+        Dict_Find((dict), (key), _hash, &_group, &_slot);                                                 \
+        (length_out) = 1;                                                                                 \
+        while ((hit) ? _probe.index != _group                                                             \
+                     : !Dict_EmptyBitmask((dict)->metadata_group[_probe.index])) {                        \
+            Dict_ProbeNext((dict), &_probe);                                                              \
+            (length_out) += 1;                                                                            \
+        }                                                                                                 \
+    } while (0)
+
+#define RUN(dict, keys, misses, count, result)                                         \
+    do {                                                                               \
+        assert(Dict_Init((dict), 0));                                                  \
+        for (size_t _ii = 0; _ii < (count); _ii++) {                                   \
+            assert(Dict_Set((dict), (keys)[_ii], _ii));                                \
+        }                                                                              \
+        uint64_t _total = 0, _length;                                                  \
+        (result).hit_max = (result).miss_max = 0;                                      \
+        for (size_t _ii = 0; _ii < (count); _ii++) {                                   \
+            PROBE_LENGTH((dict), (keys)[_ii], true, _length);                          \
+            _total += _length;                                                         \
+            (result).hit_max = CTL_MAX((result).hit_max, _length);                     \
+        }                                                                              \
+        (result).hit_avg = (double)_total / (double)(count);                           \
+        _total           = 0;                                                          \
+        for (size_t _ii = 0; _ii < (count); _ii++) {                                   \
+            PROBE_LENGTH((dict), (misses)[_ii], false, _length);                       \
+            _total += _length;                                                         \
+            (result).miss_max = CTL_MAX((result).miss_max, _length);                   \
+        }                                                                              \
+        (result).miss_avg = (double)_total / (double)(count);                          \
+        uint64_t _out;                                                                 \
+        double   _start = Bench_Now();                                                 \
+        for (size_t _ii = 0; _ii < (count); _ii++) {                                   \
+            Bench_Consume(Dict_Get((dict), (misses)[_ii], &_out));                     \
+        }                                                                              \
+        (result).miss_ns = (Bench_Now() - _start) * 1e9 / (double)(count);             \
+        Dict_Uninit((dict));                                                           \
+    } while (0)
+
+static void Print(const char* policy, Result result) {
+    printf(
+        "  %-10s hit avg %.3f max %3lu   miss avg %.3f max %3lu   miss %.1f ns\n",
+        policy,
+        result.hit_avg,
+        result.hit_max,
+        result.miss_avg,
+        result.miss_max,
+        result.miss_ns);
+}
+
+int main(void) {
+    // right at the default growth threshold (7/8ths) of a 2^21 slot table
+    const size_t count = (1 << 21) / 8 * 7;
+
+    const char* distributions[] = {"sequential", "strided (x4096)", "random"};
+
+    uint64_t* keys   = malloc(sizeof(uint64_t) * count);
+    uint64_t* misses = malloc(sizeof(uint64_t) * count);
+
+    for (size_t dd = 0; dd < 3; dd++) {
+        uint64_t rng = 42;
+
+        for (size_t ii = 0; ii < count; ii++) {
+            switch (dd) {
+                case 0:
+                    keys[ii]   = ii;
+                    misses[ii] = count + ii;
+                    break;
+                case 1:
+                    keys[ii]   = ii * 4096;
+                    misses[ii] = (count + ii) * 4096;
+                    break;
+                case 2:
+                    keys[ii]   = Bench_Rand(&rng);
+                    misses[ii] = Bench_Rand(&rng);
+                    break;
+            }
+        }
+
+        Dict(u64_linear, uint64_t) linear;
+        Dict(u64_triangular, uint64_t) triangular;
+        Dict(u64_stride, uint64_t) stride;
+        Result result;
+
+        printf("%s keys, n=%zu\n", distributions[dd], count);
+
+        RUN(&linear, keys, misses, count, result);
+        Print("linear", result);
+        RUN(&triangular, keys, misses, count, result);
+        Print("triangular", result);
+        RUN(&stride, keys, misses, count, result);
+        Print("stride", result);
+    }
+
+    free(keys);
+    free(misses);
+
+    return 0;
+}
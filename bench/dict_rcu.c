@@ -0,0 +1,146 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* Read-mostly tables, reader threads look up random keys of a small (cache resident) table while one writer changes
+ * an entry every WRITE_INTERVAL_US, as a pthread rwlock around a dict vs Dict_Rcu. Every rwlock read locks and
+ * unlocks, two atomic writes to the lock's cache line which every reader shares, a Dict_Rcu read stores to the
+ * reader's own slot. Readers scale from 1 to the core count. Usage: dict_rcu [max readers] */
+
+#define KEYS              (1 << 12)
+#define OPS               (1 << 22)
+#define WRITE_INTERVAL_US 10000
+
+typedef struct {
+    Dict(uint64_t, uint64_t) * dict;
+    pthread_rwlock_t* rwlock;
+    Dict_Rcu(uint64_t, uint64_t) * rcu;
+    size_t             reader_index;
+    pthread_barrier_t* barrier;
+    volatile bool*     done;
+} Bench_Thread;
+
+static void* Bench_Reader(void* arg) {
+    Bench_Thread* thread = arg;
+    uint64_t      rng    = 0x9E3779B97F4A7C15ull * (thread->reader_index + 1);
+    uint64_t      sum    = 0;
+
+    pthread_barrier_wait(thread->barrier);
+    for (size_t ii = 0; ii < OPS; ii++) {
+        uint64_t key = Bench_Rand(&rng) % KEYS;
+        uint64_t val = 0;
+
+        if (thread->rcu != NULL) {
+            Dict_Get(thread->rcu, thread->reader_index, key, &val);
+        } else {
+            pthread_rwlock_rdlock(thread->rwlock);
+            Dict_Get(thread->dict, key, &val);
+            pthread_rwlock_unlock(thread->rwlock);
+        }
+
+        sum += val;
+    }
+
+    Bench_Consume(sum);
+    return NULL;
+}
+
+static void* Bench_Writer(void* arg) {
+    Bench_Thread* thread = arg;
+    uint64_t      rng    = 42;
+
+    while (!*thread->done) {
+        uint64_t key = Bench_Rand(&rng) % KEYS;
+
+        if (thread->rcu != NULL) {
+            Dict_Set(thread->rcu, key, rng);
+        } else {
+            pthread_rwlock_wrlock(thread->rwlock);
+            Dict_Set(thread->dict, key, rng);
+            pthread_rwlock_unlock(thread->rwlock);
+        }
+
+        usleep(WRITE_INTERVAL_US);
+    }
+
+    return NULL;
+}
+
+// runs reader_count readers and the writer against either dict, returns the readers' total Mlookup/s
+static double Bench_Readers(
+    Dict(uint64_t, uint64_t) * dict,
+    pthread_rwlock_t* rwlock,
+    Dict_Rcu(uint64_t, uint64_t) * rcu,
+    size_t reader_count) {
+    pthread_t*        threads = malloc(sizeof(pthread_t) * (reader_count + 1));
+    Bench_Thread*     args    = malloc(sizeof(Bench_Thread) * (reader_count + 1));
+    volatile bool     done    = false;
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, reader_count + 1);
+
+    for (size_t ii = 0; ii <= reader_count; ii++) {
+        args[ii] = (Bench_Thread){dict, rwlock, rcu, ii, &barrier, &done};
+        assert(pthread_create(&threads[ii], NULL, ii < reader_count ? Bench_Reader : Bench_Writer, &args[ii]) == 0);
+    }
+
+    pthread_barrier_wait(&barrier);
+    double start = Bench_Now();
+    for (size_t ii = 0; ii < reader_count; ii++) {
+        pthread_join(threads[ii], NULL);
+    }
+    double elapsed = Bench_Now() - start;
+
+    done = true;
+    pthread_join(threads[reader_count], NULL);
+
+    pthread_barrier_destroy(&barrier);
+    free(threads);
+    free(args);
+    return (double)OPS * reader_count / elapsed / 1e6;
+}
+
+int main(int argc, char** argv) {
+    long   cores       = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_readers = argc > 1 ? (size_t)atol(argv[1]) : (size_t)(cores > 0 ? cores : 1);
+
+    printf("%-8s %18s %18s %8s\n", "readers", "rwlock Mlookup/s", "rcu Mlookup/s", "speedup");
+
+    // 1, 2, 4, ... readers, ending at exactly max_readers
+    size_t next_readers;
+    for (size_t readers = 1; readers <= max_readers; readers = next_readers) {
+        next_readers = readers == max_readers ? readers + 1 : CTL_MIN(readers * 2, max_readers);
+
+        Dict(uint64_t, uint64_t) dict;
+        Dict_Rcu(uint64_t, uint64_t) rcu;
+        pthread_rwlock_t rwlock = PTHREAD_RWLOCK_INITIALIZER;
+
+        assert(Dict_Init(&dict, 0));
+        assert(Dict_InitRcu(&rcu, 0, readers));
+
+        Dict(uint64_t, uint64_t)* write = Dict_WriteBegin(&rcu);
+        for (uint64_t key = 0; key < KEYS; key++) {
+            assert(Dict_Set(&dict, key, key));
+            assert(Dict_Set(write, key, key));
+        }
+        Dict_Publish(&rcu, write);
+
+        double rwlock_rate = Bench_Readers(&dict, &rwlock, NULL, readers);
+        double rcu_rate    = Bench_Readers(NULL, NULL, &rcu, readers);
+        printf("%-8zu %18.1f %18.1f %7.2fx\n", readers, rwlock_rate, rcu_rate, rcu_rate / rwlock_rate);
+
+        Dict_Uninit(&dict);
+        Dict_Uninit(&rcu);
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#include "containers/dict.h"
+
+/* Multi-threaded Get/Set throughput, one dict behind a global mutex vs a sharded dict, from 1 thread up to the core
+ * count. Every thread runs OPS operations on random keys out of KEYS preloaded ones, 90% Dict_Get and 10% Dict_Set
+ * (half of those insert a key that wasn't loaded, so shards keep growing during the run). Usage: dict_sharded
+ * [max threads] */
+
+#define KEYS   (1 << 20)
+#define OPS    (1 << 21)
+#define SHARDS 64
+
+typedef struct {
+    Dict(uint64_t, uint64_t) * dict;
+    pthread_mutex_t* mutex;
+    Dict_Sharded(uint64_t, uint64_t) * sharded;
+    pthread_barrier_t* barrier;
+    uint64_t           seed;
+} Bench_Worker;
+
+static void* Bench_Run(void* arg) {
+    Bench_Worker* worker = arg;
+    uint64_t      rng    = worker->seed;
+    uint64_t      sum    = 0;
+
+    pthread_barrier_wait(worker->barrier);
+    for (size_t ii = 0; ii < OPS; ii++) {
+        uint64_t rand = Bench_Rand(&rng);
+        uint64_t key  = (rand >> 8) % (rand % 20 == 0 ? 2 * KEYS : KEYS);
+        uint64_t val  = 0;
+
+        if (worker->sharded != NULL) {
+            if (rand % 10 == 0) {
+                Dict_Set(worker->sharded, key, rand);
+            } else {
+                Dict_Get(worker->sharded, key, &val);
+            }
+        } else {
+            pthread_mutex_lock(worker->mutex);
+            if (rand % 10 == 0) {
+                Dict_Set(worker->dict, key, rand);
+            } else {
+                Dict_Get(worker->dict, key, &val);
+            }
+            pthread_mutex_unlock(worker->mutex);
+        }
+
+        sum += val;
+    }
+
+    Bench_Consume(sum);
+    return NULL;
+}
+
+// runs thread_count workers against either dict, returns the total Mop/s
+static double Bench_Threads(
+    Dict(uint64_t, uint64_t) * dict,
+    pthread_mutex_t* mutex,
+    Dict_Sharded(uint64_t, uint64_t) * sharded,
+    size_t thread_count) {
+    pthread_t*        threads = malloc(sizeof(pthread_t) * thread_count);
+    Bench_Worker*     workers = malloc(sizeof(Bench_Worker) * thread_count);
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, thread_count + 1);
+
+    for (size_t ii = 0; ii < thread_count; ii++) {
+        workers[ii] = (Bench_Worker){dict, mutex, sharded, &barrier, 0x9E3779B97F4A7C15ull * (ii + 1)};
+        assert(pthread_create(&threads[ii], NULL, Bench_Run, &workers[ii]) == 0);
+    }
+
+    pthread_barrier_wait(&barrier);
+    double start = Bench_Now();
+    for (size_t ii = 0; ii < thread_count; ii++) {
+        pthread_join(threads[ii], NULL);
+    }
+    double elapsed = Bench_Now() - start;
+
+    pthread_barrier_destroy(&barrier);
+    free(threads);
+    free(workers);
+    return (double)OPS * thread_count / elapsed / 1e6;
+}
+
+int main(int argc, char** argv) {
+    long   cores       = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = argc > 1 ? (size_t)atol(argv[1]) : (size_t)(cores > 0 ? cores : 1);
+
+    printf("%-8s %18s %18s %8s\n", "threads", "mutex Mop/s", "sharded Mop/s", "speedup");
+
+    // 1, 2, 4, ... threads, ending at exactly max_threads
+    size_t next_threads;
+    for (size_t threads = 1; threads <= max_threads; threads = next_threads) {
+        next_threads = threads == max_threads ? threads + 1 : CTL_MIN(threads * 2, max_threads);
+
+        Dict(uint64_t, uint64_t) dict;
+        Dict_Sharded(uint64_t, uint64_t) sharded;
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+        assert(Dict_Init(&dict, 0));
+        assert(Dict_InitSharded(&sharded, 0, SHARDS));
+
+        for (uint64_t key = 0; key < KEYS; key++) {
+            assert(Dict_Set(&dict, key, key));
+            assert(Dict_Set(&sharded, key, key));
+        }
+
+        double mutex_rate   = Bench_Threads(&dict, &mutex, NULL, threads);
+        double sharded_rate = Bench_Threads(NULL, NULL, &sharded, threads);
+        printf("%-8zu %18.1f %18.1f %7.2fx\n", threads, mutex_rate, sharded_rate, sharded_rate / mutex_rate);
+
+        Dict_Uninit(&dict);
+        Dict_Uninit(&sharded);
+    }
+
+    return 0;
+}
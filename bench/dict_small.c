@@ -0,0 +1,84 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* Lots of short-lived tiny dicts (think per-request headers), each gets created, filled with 1-20 entries, queried
+ * and destroyed. Counts heap allocations and time with and without Dict_Inline. */
+
+static size_t allocations = 0;
+
+static void* Bench_Malloc(size_t bytes) {
+    allocations += 1;
+    return calloc(1, bytes);
+}
+
+typedef uint64_t u64_inline;
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType uint64_t
+#define Dict_Malloc    Bench_Malloc
+#define Dict_Realloc   realloc
+#define Dict_Free      free
+#include "containers/dict.h"
+
+#define Dict_KeyType   u64_inline
+#define Dict_ValueType uint64_t
+#define Dict_Malloc    Bench_Malloc
+#define Dict_Realloc   realloc
+#define Dict_Free      free
+#define Dict_Inline
+#include "containers/dict.h"
+
+#define DICTS 4000000
+
+#define RUN(dict, max_entries)                                                \
+    do {                                                                      \
+        uint64_t _rng = 42, _sum = 0, _out;                                   \
+        allocations   = 0;                                                    \
+        double _start = Bench_Now();                                          \
+        for (size_t _ii = 0; _ii < DICTS; _ii++) {                            \
+            size_t _entries = 1 + Bench_Rand(&_rng) % (max_entries);          \
+            assert(Dict_Init((dict), 0));                                     \
+            for (size_t _jj = 0; _jj < _entries; _jj++) {                     \
+                Dict_Set((dict), _jj * 0x9E3779B97F4A7C15ull, _jj);           \
+            }                                                                 \
+            for (size_t _jj = 0; _jj < 4; _jj++) {                            \
+                _sum += Dict_Get((dict), _jj * 0x9E3779B97F4A7C15ull, &_out); \
+            }                                                                 \
+            Dict_Uninit((dict));                                              \
+        }                                                                     \
+        Bench_Consume(_sum);                                                  \
+        elapsed = Bench_Now() - _start;                                       \
+    } while (0)
+
+int main(void) {
+    const size_t max_entries[] = {8, 14, 20};
+
+    Dict(uint64_t, uint64_t) dict;
+    Dict(u64_inline, uint64_t) dict_inline;
+    double elapsed;
+
+    printf("%d dicts, create + fill + 4 lookups + destroy\n", DICTS);
+
+    for (size_t ii = 0; ii < sizeof(max_entries) / sizeof(max_entries[0]); ii++) {
+        RUN(&dict, max_entries[ii]);
+        printf(
+            "  1-%-2zu entries  heap   %8zu allocations  %6.1f ns/dict\n",
+            max_entries[ii],
+            allocations,
+            elapsed * 1e9 / DICTS);
+
+        RUN(&dict_inline, max_entries[ii]);
+        printf(
+            "  1-%-2zu entries  inline %8zu allocations  %6.1f ns/dict\n",
+            max_entries[ii],
+            allocations,
+            elapsed * 1e9 / DICTS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType       char*
+#define Dict_KeyType_Alias str
+#define Dict_ValueType     int
+#include "containers/dict.h"
+
+/* String hashing throughput in GB/s for the old byte at a time FNV-1a path against the word at a time hashes, over
+ * key lengths typical of our workloads. The key set is kept small enough to stay in cache so this measures the hash
+ * and not the memory system. */
+
+static uint64_t Legacy_HashKey_Str(const char* str) {
+    uint64_t hash = 0xcbf29ce484222325;
+
+    while (*str) {
+        hash ^= *str++;
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+#define MEASURE(expr, keys, stride, count, reps, len)                        \
+    ({                                                                       \
+        uint64_t _acc   = 0;                                                 \
+        double   _start = Bench_Now();                                       \
+        for (size_t _rep = 0; _rep < (reps); _rep++) {                       \
+            for (size_t _ii = 0; _ii < (count); _ii++) {                     \
+                const char* key = (keys) + _ii * (stride);                   \
+                _acc += (expr);                                              \
+            }                                                                \
+        }                                                                    \
+        double _elapsed = Bench_Now() - _start;                              \
+        Bench_Consume(_acc);                                                 \
+        (double)(count) * (double)(reps) * (double)(len) / _elapsed / 1e9;   \
+    })
+
+int main(void) {
+    const size_t   lengths[] = {8, 16, 40, 64, 100, 200};
+    const size_t   count     = 1024;
+    const size_t   reps      = 2000;
+    const uint64_t seed      = Dict_RandomSeed(&reps);
+
+    printf("%-6s %8s %8s %8s %8s\n", "len", "fnv1a", "wyhash", "Str", "StrN");
+
+    for (size_t ll = 0; ll < sizeof(lengths) / sizeof(lengths[0]); ll++) {
+        size_t len    = lengths[ll];
+        size_t stride = len + 1;
+        char*  keys   = malloc(count * stride);
+
+        uint64_t rng = 7;
+        for (size_t ii = 0; ii < count * stride; ii++) {
+            keys[ii] = (ii % stride == len) ? '\0' : 'a' + Bench_Rand(&rng) % 26;
+        }
+
+        double fnv = MEASURE(Legacy_HashKey_Str(key), keys, stride, count, reps, len);
+        double wy  = MEASURE(Dict_HashBytes_Wy(key, len, seed), keys, stride, count, reps, len);
+        double str  = MEASURE(Dict_HashKey_Str(key, seed), keys, stride, count, reps, len);
+        double strn = MEASURE(Dict_HashKey_StrN(key, len, seed), keys, stride, count, reps, len);
+
+        printf("%-6zu %8.2f %8.2f %8.2f %8.2f\n", len, fnv, wy, str, strn);
+
+        free(keys);
+    }
+
+    return 0;
+}
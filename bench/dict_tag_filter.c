@@ -0,0 +1,118 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* Counts Dict_CompareKey calls per lookup, every call past the first on a hit (and every call on a miss) is a tag
+ * false positive. The legacy hash reproduces the old pipeline where the group index and the tag came from the same
+ * low bits of a 32-bit hash: its low bits are bit-reversed into the high bits that now pick the group. */
+
+static uint64_t compare_calls = 0;
+
+static inline uint32_t Legacy_Hash32(uint32_t x) {
+    x ^= x >> 17;
+    x *= 0xed5ad4bb;
+    x ^= x >> 11;
+    x *= 0xac4c1b51;
+    x ^= x >> 15;
+    x *= 0x31848bab;
+    x ^= x >> 14;
+    return x;
+}
+
+static inline uint64_t Legacy_HashKey(uint64_t key) {
+    uint32_t hash = Legacy_Hash32((uint32_t)key) ^ Legacy_Hash32((uint32_t)(key >> 32));
+    uint32_t rev  = hash;
+
+    rev = ((rev >> 1) & 0x55555555) | ((rev & 0x55555555) << 1);
+    rev = ((rev >> 2) & 0x33333333) | ((rev & 0x33333333) << 2);
+    rev = ((rev >> 4) & 0x0F0F0F0F) | ((rev & 0x0F0F0F0F) << 4);
+    rev = __builtin_bswap32(rev);
+
+    return ((uint64_t)rev << 32) | (hash & 0x7F);
+}
+
+typedef uint64_t legacy_u64;
+
+#define Dict_KeyType            legacy_u64
+#define Dict_ValueType          uint64_t
+#define Dict_HashKey(key)       Legacy_HashKey(key)
+#define Dict_CompareKey(k1, k2) (compare_calls++, (k1) == (k2))
+#include "containers/dict.h"
+
+#define Dict_KeyType            uint64_t
+#define Dict_ValueType          uint64_t
+#define Dict_CompareKey(k1, k2) (compare_calls++, (k1) == (k2))
+#include "containers/dict.h"
+
+#define RUN_LOOKUPS(dict, keys, count, result)                                    \
+    do {                                                                          \
+        uint64_t _out;                                                            \
+        compare_calls = 0;                                                        \
+        double _start = Bench_Now();                                              \
+        for (size_t _ii = 0; _ii < (count); _ii++) {                              \
+            Bench_Consume(Dict_Get((dict), (keys)[_ii], &_out));                  \
+        }                                                                         \
+        (result).seconds       = Bench_Now() - _start;                            \
+        (result).compares_per  = (double)compare_calls / (double)(count);         \
+        (result).lookups_per_s = (double)(count) / (result).seconds;              \
+    } while (0)
+
+typedef struct {
+    double seconds;
+    double compares_per;
+    double lookups_per_s;
+} Result;
+
+int main(void) {
+    const size_t sizes[] = {1 << 10, 1 << 16, 1 << 20};
+
+    for (size_t ii = 0; ii < sizeof(sizes) / sizeof(sizes[0]); ii++) {
+        size_t    count  = sizes[ii];
+        uint64_t* hits   = malloc(sizeof(uint64_t) * count);
+        uint64_t* misses = malloc(sizeof(uint64_t) * count);
+        uint64_t  rng    = 12345;
+
+        Dict(legacy_u64, uint64_t) legacy;
+        Dict(uint64_t, uint64_t) split;
+        assert(Dict_Init(&legacy, 0));
+        assert(Dict_Init(&split, 0));
+
+        for (size_t jj = 0; jj < count; jj++) {
+            hits[jj]   = Bench_Rand(&rng);
+            misses[jj] = Bench_Rand(&rng);
+            assert(Dict_Set(&legacy, hits[jj], jj));
+            assert(Dict_Set(&split, hits[jj], jj));
+        }
+
+        Result legacy_hit, legacy_miss, split_hit, split_miss;
+        RUN_LOOKUPS(&legacy, hits, count, legacy_hit);
+        RUN_LOOKUPS(&legacy, misses, count, legacy_miss);
+        RUN_LOOKUPS(&split, hits, count, split_hit);
+        RUN_LOOKUPS(&split, misses, count, split_miss);
+
+        printf(
+            "n=%-8zu compares/lookup   hit: legacy %.3f split %.3f   miss: legacy %.3f split %.3f\n",
+            count,
+            legacy_hit.compares_per,
+            split_hit.compares_per,
+            legacy_miss.compares_per,
+            split_miss.compares_per);
+        printf(
+            "           Mlookups/s         hit: legacy %.1f  split %.1f    miss: legacy %.1f  split %.1f\n",
+            legacy_hit.lookups_per_s / 1e6,
+            split_hit.lookups_per_s / 1e6,
+            legacy_miss.lookups_per_s / 1e6,
+            split_miss.lookups_per_s / 1e6);
+
+        Dict_Uninit(&legacy);
+        Dict_Uninit(&split);
+        free(hits);
+        free(misses);
+    }
+
+    return 0;
+}
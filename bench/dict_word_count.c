@@ -0,0 +1,73 @@
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType       Dict_StrView
+#define Dict_KeyType_Alias strview
+#define Dict_ValueType     uint64_t
+#include "containers/dict.h"
+
+/* Word counting over a skewed (log-uniform ranked) stream of words, Dict_Get followed by Dict_Set hashes and probes
+ * every word twice, Dict_Upsert once. */
+
+#define VOCABULARY 200000
+#define WORDS      (1 << 24)
+#define WORD_BYTES 16
+
+int main(void) {
+    char*         arena = malloc((size_t)VOCABULARY * WORD_BYTES);
+    Dict_StrView* words = malloc(sizeof(Dict_StrView) * WORDS);
+    uint64_t      rng   = 42;
+
+    for (size_t ii = 0; ii < WORDS; ii++) {
+        double u    = (double)(Bench_Rand(&rng) >> 11) / (double)(1ull << 53);
+        size_t rank = (size_t)exp(u * log(VOCABULARY));
+        char*  word = arena + rank % VOCABULARY * WORD_BYTES;
+
+        words[ii].ptr = word;
+        words[ii].len = snprintf(word, WORD_BYTES, "word%zu", rank % VOCABULARY);
+    }
+
+    Dict(strview, uint64_t) counts;
+    assert(Dict_Init(&counts, 0));
+
+    double start = Bench_Now();
+    for (size_t ii = 0; ii < WORDS; ii++) {
+        uint64_t count = 0;
+        Dict_Get(&counts, words[ii], &count);
+        Dict_Set(&counts, words[ii], count + 1);
+    }
+    double get_set = Bench_Now() - start;
+
+    size_t   distinct = counts.size;
+    uint64_t check    = 0;
+    Dict_Get(&counts, words[0], &check);
+    Dict_Uninit(&counts);
+
+    assert(Dict_Init(&counts, 0));
+    start = Bench_Now();
+    for (size_t ii = 0; ii < WORDS; ii++) {
+        *Dict_Upsert(&counts, words[ii], NULL) += 1;
+    }
+    double upsert = Bench_Now() - start;
+
+    assert(counts.size == distinct && *Dict_GetPtr(&counts, words[0]) == check);
+    Dict_Uninit(&counts);
+
+    printf(
+        "%d words, %zu distinct  Get+Set %6.1f Mword/s  Upsert %6.1f Mword/s  (%.2fx)\n",
+        WORDS,
+        distinct,
+        WORDS / get_set / 1e6,
+        WORDS / upsert / 1e6,
+        get_set / upsert);
+
+    free(words);
+    free(arena);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "containers/idict.h"
+
+/* Indexing 200-byte records by id, a Dict storing the records by value (every Dict_Set copies a record into the
+ * table, every grow copies it again) vs an IDict over the records where they already are (the table holds pointers,
+ * a grow moves 8 bytes per record). Times building the index from an empty table, growing along the way, then random
+ * lookups reading a field of the record found. */
+
+#define LOOKUPS (1 << 22)
+
+typedef struct {
+    uint64_t   id;
+    IDict_Link link;
+    uint8_t    payload[184];
+} record;
+
+_Static_assert(sizeof(record) == 200, "records are meant to be 200 bytes");
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType record
+#include "containers/dict.h"
+
+#define IDict_Type      record
+#define IDict_KeyType   uint64_t
+#define IDict_KeyField  id
+#define IDict_LinkField link
+#include "containers/idict.h"
+
+static void Bench_Records(size_t count) {
+    record* records = calloc(count, sizeof(record));
+    for (size_t ii = 0; ii < count; ii++) {
+        records[ii].id         = Dict_Mix64(ii);
+        records[ii].payload[0] = (uint8_t)ii;
+    }
+
+    Dict(uint64_t, record) dict;
+    IDict(record) idict;
+    assert(Dict_Init(&dict, 0) && IDict_Init(&idict, 0));
+
+    double start = Bench_Now();
+    for (size_t ii = 0; ii < count; ii++) {
+        assert(Dict_Set(&dict, records[ii].id, records[ii]));
+    }
+    double dict_build = Bench_Now() - start;
+
+    start = Bench_Now();
+    for (size_t ii = 0; ii < count; ii++) {
+        assert(IDict_Insert(&idict, &records[ii]) == &records[ii]);
+    }
+    double idict_build = Bench_Now() - start;
+
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    uint64_t sum = 0;
+    start        = Bench_Now();
+    for (size_t ii = 0; ii < LOOKUPS; ii++) {
+        sum += Dict_GetPtr(&dict, Dict_Mix64(Bench_Rand(&rng) % count))->payload[0];
+    }
+    double dict_lookup = Bench_Now() - start;
+
+    rng   = 0x9E3779B97F4A7C15ull;
+    start = Bench_Now();
+    for (size_t ii = 0; ii < LOOKUPS; ii++) {
+        sum -= IDict_Find(&idict, Dict_Mix64(Bench_Rand(&rng) % count))->payload[0];
+    }
+    double idict_lookup = Bench_Now() - start;
+
+    // both looked up the same records
+    assert(sum == 0);
+
+    printf(
+        "%-9zu %10.1f %10.1f %8.2fx %10.1f %10.1f %8.2fx %9.1f %9.1f\n",
+        count,
+        count / dict_build / 1e6,
+        count / idict_build / 1e6,
+        dict_build / idict_build,
+        LOOKUPS / dict_lookup / 1e6,
+        LOOKUPS / idict_lookup / 1e6,
+        dict_lookup / idict_lookup,
+        Dict_TableSize(&dict, dict.capacity) / 1e6,
+        idict.capacity / 16 * (sizeof(Dict_MetadataGroup) + 16 * sizeof(record*)) / 1e6);
+
+    Dict_Uninit(&dict);
+    IDict_Uninit(&idict);
+    free(records);
+}
+
+int main(void) {
+    printf(
+        "%-9s %10s %10s %9s %10s %10s %9s %9s %9s\n",
+        "records",
+        "dict Mi/s",
+        "idict Mi/s",
+        "speedup",
+        "dict Ml/s",
+        "idict Ml/s",
+        "speedup",
+        "dict MB",
+        "idict MB");
+
+    Bench_Records(1 << 12);
+    Bench_Records(1 << 16);
+    Bench_Records(1 << 20);
+
+    return 0;
+}
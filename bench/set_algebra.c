@@ -0,0 +1,103 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+#define Dict_KeyType   uint64_t
+#define Dict_ValueType bool
+#include "containers/dict.h"
+
+#define Set_KeyType uint64_t
+#include "containers/set.h"
+
+/* A set of 64-bit keys as a Set vs as a Dict with bool values (a value per key that's never read), comparing the
+ * memory their tables take and intersection throughput. The dict's intersection loops over the smaller dict's keys,
+ * looks each one up in the larger dict and sets it in the result, Set_Intersect does the same a group at a time. Half
+ * of the smaller set's keys are in the larger one. */
+
+#define ROUNDS 8
+
+// the smaller set has small_size keys, every other one of them is one of large_size keys in the larger set
+static void Bench_Intersect(size_t small_size, size_t large_size) {
+    Dict(uint64_t, bool) small_dict, large_dict, result_dict;
+    Set(uint64_t) small_set, large_set, result_set;
+
+    assert(Dict_Init(&small_dict, 0) && Dict_Init(&large_dict, 0) && Dict_Init(&result_dict, 0));
+    assert(Set_Init(&small_set, 0) && Set_Init(&large_set, 0) && Set_Init(&result_set, 0));
+
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    for (size_t ii = 0; ii < large_size; ii++) {
+        uint64_t key = Dict_Mix64(ii);
+        assert(Dict_Set(&large_dict, key, true) && Set_Insert(&large_set, key));
+    }
+    for (size_t ii = 0; ii < small_size; ii++) {
+        uint64_t key = Dict_Mix64(ii % 2 == 0 ? Bench_Rand(&rng) % large_size : large_size + ii);
+        assert(Dict_Set(&small_dict, key, true) && Set_Insert(&small_set, key));
+    }
+
+    double start = Bench_Now();
+    for (int round = 0; round < ROUNDS; round++) {
+        Dict_Clear(&result_dict);
+        assert(Dict_Reserve(&result_dict, small_dict.size));
+        Dict_ForEach(&small_dict, key, val) {
+            (void)val;
+            if (Dict_GetPtr(&large_dict, *key) != NULL) {
+                assert(Dict_Set(&result_dict, *key, true));
+            }
+        }
+    }
+    double dict_time = (Bench_Now() - start) / ROUNDS;
+
+    start = Bench_Now();
+    for (int round = 0; round < ROUNDS; round++) {
+        assert(Set_Intersect(&result_set, &small_set, &large_set));
+    }
+    double set_time = (Bench_Now() - start) / ROUNDS;
+
+    assert(result_set.size == result_dict.size);
+
+    // bytes of each larger table, Dict_TableSize also counts the value groups
+    double dict_mb = Dict_TableSize(&large_dict, large_dict.capacity) / 1e6;
+    double set_mb  = large_set.capacity / 16 * (sizeof(Dict_MetadataGroup) + 16 * sizeof(uint64_t)) / 1e6;
+
+    printf(
+        "%-9zu %-9zu %9.1f %9.1f %14.1f %14.1f %8.2fx\n",
+        small_size,
+        large_size,
+        dict_mb,
+        set_mb,
+        small_size / dict_time / 1e6,
+        small_size / set_time / 1e6,
+        dict_time / set_time);
+
+    Dict_Uninit(&small_dict);
+    Dict_Uninit(&large_dict);
+    Dict_Uninit(&result_dict);
+    Set_Uninit(&small_set);
+    Set_Uninit(&large_set);
+    Set_Uninit(&result_set);
+}
+
+int main(void) {
+    printf(
+        "%-9s %-9s %9s %9s %14s %14s %8s\n",
+        "small",
+        "large",
+        "dict MB",
+        "set MB",
+        "dict Mkey/s",
+        "set Mkey/s",
+        "speedup");
+
+    Bench_Intersect(1 << 12, 1 << 12);
+    Bench_Intersect(1 << 12, 1 << 20);
+    Bench_Intersect(1 << 16, 1 << 16);
+    Bench_Intersect(1 << 16, 1 << 22);
+    Bench_Intersect(1 << 20, 1 << 20);
+    Bench_Intersect(1 << 20, 1 << 22);
+
+    return 0;
+}
@@ -1,6 +1,4 @@
 // TODO: There's code shared between EnumerateKeys, EnumerateValues, and Grow that should be commonized
-// TODO: Dict_Enumerate returning a Tuple(key, value)? Would work but the API might get ugly
-// TODO: Should we use a 64-bit hash function?
 // TODO: Should we use a ligher weight integer hashing function?
 // TODO: Should we provide a hash function/compare function for void*?
 
@@ -16,28 +14,118 @@
         Dict_ValueType_Alias: Alias for the value type
 
         Dict_CompareKey(key1, key2): A comparison function for the key type
-        Dict_HashKey(key):           A hash function for the key type that results in a uint32_t, defaults provided
+        Dict_HashKey(key):           A hash function for the key type that results in a uint64_t (or uint32_t),
+                                     defaults provided, a uint64_t result is mixed before use (see Notes)
 
     -- Optional --
+        Dict_Probing: The group probing policy used on collisions, one of
+            Dict_Probing_Linear:     visit groups in order, best locality but clusters under weak hashes
+            Dict_Probing_Triangular: visit groups at triangular number offsets (default)
+            Dict_Probing_Stride:     visit groups at a fixed odd stride taken from the hash (double hashing)
+
+        Dict_Layout: How a group's keys and values are laid out in memory, one of
+            Dict_Layout_Split:       a group's 16 keys are stored together, then its 16 values (default), best when
+                                     lookups mostly miss or keys are compared far more often than values are read
+            Dict_Layout_Interleaved: each key is stored next to its value, a hit then touches one cache line for
+                                     both, best for small keys and values looked up in a table bigger than the cache
+            Dict_Layout_Ordered:     the entries are kept densely in insertion order (as in Python's dict) and the
+                                     slots only hold their 32-bit indices, iteration visits the entries in the order
+                                     they were added and costs the number of entries instead of the capacity.
+                                     Removed entries leave a hole until the table grows or is rehashed, lookups
+                                     make one more dependent load. Can't be combined with Dict_Incremental,
+                                     Dict_GrowInPlace, Dict_Inline or Dict_Mappable
+
+        Dict_CacheHash: If defined, the full hash of every entry is stored alongside it, growing the table then
+                        never rehashes keys and lookups compare hashes before keys, worthwhile for expensive
+                        keys like char*
+
+        Dict_Incremental: If defined, growing allocates the new table but leaves the entries in the old one, every
+                          Dict_Set/Dict_Get/Dict_Remove then migrates this many groups of the old table (1 if it's
+                          defined empty) until it is empty, bounding the worst case cost of an insert at the
+                          expense of lookups checking both tables while a migration is running
+
+        Dict_GrowInPlace: If defined, growing reallocs the table's block with Dict_Realloc and redistributes the
+                          entries inside it, so the old and new tables aren't both live while growing, can't be
+                          combined with Dict_Incremental
+
+        Dict_Inline: If defined, the dict's first group is stored inside the Dict struct, a dict with a capacity of
+                     16 (up to 14 entries with the default max load) then needs no heap allocation, it spills to
+                     the heap when it grows. A dict using its inline group can't be moved by assignment or memcpy
+
+        Dict_Stats: If defined, the dict counts what its lookups and growth cost in its stats member, see
+                    Dict_Counters, and Dict_PrintStats dumps them along with how full its groups are. Meant for
+                    telling a bad Dict_HashKey, clustering and load apart, adds a few adds and branches to every
+                    lookup so leave it off outside of profiling. Probes of the table being migrated away from with
+                    Dict_Incremental aren't counted
+
+        Dict_Mappable: If defined, Dict_Save writes the dict's table to a file and Dict_MapFile maps such a file back
+                       in read-only without reading or rehashing it (POSIX). Only for key and value types that
+                       hold no pointers, the file is only readable by the same instantiation on the same platform
+
+        Dict_SimdKeys: If defined, 32-bit integer keys are matched against a whole group's keys with SIMD compares
+                       like 8 and 16-bit keys are (see Notes), a group of them fills a cache line and this measured
+                       slower than the tag path once the table doesn't fit in the cache, so it's opt in
+
+        Dict_MaxLoad(capacity): The most entries (including tombstones) a table of capacity slots holds before it
+                                grows, must be less than capacity, defaults to 7/8ths of the capacity
+
+        Dict_LookupType:                  A second type that can be used to look up keys, e.g. Dict_StrView for
+                                          char* keys
+        Dict_HashLookup(lookup):          Hashes a lookup, must match Dict_HashKey for an equal key, defaults provided
+        Dict_CompareLookup(lookup, key):  Compares a lookup against a key, defaults provided
+
         Dict_Malloc(bytes):       An allocator function (obeying ISO C's malloc/calloc semantics) that zero's memory
         Dict_Realloc(ptr, bytes): A reallocator function (obeying ISO C's realloc semantics)
         Dict_Free(ptr):           A free function (obeying ISO C's free semantics)
 
     -- Notes --
         Hash functions are provided for most integral types:
-            float, double, int types -- 3 round xor-shift-multiply
-            char*                    -- FNV1a
+            float, double, int types -- 64-bit xor-shift-multiply (murmur3 finalizer)
+            char*                    -- wyhash, Dict_HashKey_StrN hashes a string of known length
+        The built-in hashes are seeded per dict, Dict_Init picks a random seed and Dict_InitWithSeed takes one, so
+        keys can't be chosen ahead of time to collide. Custom Dict_HashKey/Dict_HashLookup functions aren't seeded
+        The group index is taken from the high bits of the hash and the 7-bit metadata tag from the low bits, hashes
+        narrower than 64 bits are widened with a multiplicative (fibonacci) hash so that both halves get used, and
+        64-bit hashes from a custom Dict_HashKey/Dict_HashLookup are mixed with Dict_Mix64 first, so that one that
+        leaves its high bits zero (e.g. a key cast to uint64_t) doesn't put every key in the same group
         Default compare key function is simple equality (key1 == key2) for integral types and strcmp for char*
+        With the default compare, 8 and 16-bit integer keys (and 32-bit ones with Dict_SimdKeys) are compared against
+        all of a group's candidates at once with SIMD compares (one for 8-bit keys, one or two for 16-bit keys, one to
+        four for 32-bit keys depending on AVX-512/AVX2) instead of one tag match at a time, split layout only
+        Dict_GetMany/Dict_SetMany hash and prefetch Dict_Batch_Size keys at a time before resolving them
+        Dict_Freeze builds a Dict_Frozen, an immutable minimal perfect hash table of a dict's entries that
+        Dict_Get/Dict_GetPtr/Dict_Uninit also accept
+        Dict_Sharded is a dict split into shards by hash, each a dict with its own spinlock, for sharing a dict
+        between threads, Dict_InitSharded/Dict_Uninit/Dict_Get/Dict_Set/Dict_Remove/Dict_Size accept it
+        Dict_Rcu is a dict for many reader threads and rare writes, readers take no lock and look up an immutable
+        published table, writers copy it and publish the copy in its place (read-copy-update), the old table is
+        freed once the reads using it have ended. Dict_InitRcu/Dict_Uninit/Dict_Get/Dict_Set/Dict_Remove accept it,
+        Dict_ReadBegin/Dict_ReadEnd and Dict_WriteBegin/Dict_Publish batch reads and writes
+        Dict_Merge merges one dict into another, combining the values of keys in both. Dict_Partitioned builds one
+        table on several threads, each inserts into its own dict per hash partition and the partitions are then
+        merged independently, Dict_InitPartitioned/Dict_Uninit/Dict_Upsert/Dict_MergePartition/Dict_Get accept it
 */
 
 #include <assert.h>
 #include <immintrin.h>
+#include <sched.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
 #include "../common/ctl.h"
+#include "dict_common.h"
+
+#if defined(Dict_Stats) || defined(Dict_Mappable)
+#    include <stdio.h>
+#endif
+#if defined(Dict_Mappable)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
 
 #if !defined(CTL_DICT_INCLUDED)
 #    define CTL_DICT_INCLUDED
@@ -45,142 +133,212 @@
 #    define Dict(Tkey, Tval)     CONCAT(Dict, Tkey, Tval)
 #    define Dict_New(Tkey, Tval) CONCAT(Dict_New, Tkey, Tval)
 
-/* these are internal -- don't use these */
-#    define Dict_KeyGroup(Tkey, Tval)   CONCAT(DictKeyGroup, Tkey, Tval)
-#    define Dict_ValueGroup(Tkey, Tval) CONCAT(DictValueGroup, Tkey, Tval)
-#endif
+#    define Dict_Batch_Size 16
 
-#if !defined(Dict_KeyType) || !defined(Dict_ValueType)
-#    error "Dict template requires key and value types to be defined"
-#endif
+#    define Dict_Layout_Split       1
+#    define Dict_Layout_Interleaved 2
+#    define Dict_Layout_Ordered     3
 
-#if !defined(Dict_HashKey)
-#    if !defined(CTL_DICT_COMMON_HASH)
-#        define CTL_DICT_COMMON_HASH
+#    define Dict_Iter(Tkey, Tval)        CONCAT(DictIter, Tkey, Tval)
+#    define Dict_Frozen(Tkey, Tval)      CONCAT(DictFrozen, Tkey, Tval)
+#    define Dict_Sharded(Tkey, Tval)     CONCAT(DictSharded, Tkey, Tval)
+#    define Dict_Rcu(Tkey, Tval)         CONCAT(DictRcu, Tkey, Tval)
+#    define Dict_Partitioned(Tkey, Tval) CONCAT(DictPartitioned, Tkey, Tval)
 
-static inline uint32_t Dict_Hash32(uint32_t x) {
-    x ^= x >> 17;
-    x *= 0xed5ad4bb;
-    x ^= x >> 11;
-    x *= 0xac4c1b51;
-    x ^= x >> 15;
-    x *= 0x31848bab;
-    x ^= x >> 14;
-    return x;
-}
+// the average number of entries per displacement bucket of a frozen dict, fewer makes Dict_Freeze faster at the
+// cost of a bigger displacement array
+#    define Dict_Frozen_BucketLoad 4
 
-static inline uint32_t Dict_HashKey_U8(uint8_t key) {
-    return Dict_Hash32(key);
-}
+/* Iterates over every <key, value> pair in the dict, declaring key_name and val_name as pointers to the current
+ * entry's key and value, break and continue work as they do in a regular for loop. The dict must not have entries
+ * added or removed during the loop */
+#    define Dict_ForEach(dict, key_name, val_name)                                                    \
+        for (typeof(Dict_IterStart(dict)) _dict_iter = Dict_IterStart(dict);                          \
+             _dict_iter.key == NULL && Dict_IterNext(&_dict_iter);)                                   \
+            for (typeof(_dict_iter.key) key_name = _dict_iter.key, _dict_once = key_name; _dict_once; \
+                 _dict_once = NULL)                                                                   \
+                for (typeof(_dict_iter.val) val_name = _dict_iter.val; _dict_iter.key != NULL; _dict_iter.key = NULL)
 
-static inline uint32_t Dict_HashKey_U16(uint16_t key) {
-    return Dict_Hash32(key);
-}
+/* these are internal -- don't use these */
+#    define Dict_KeyGroup(Tkey, Tval)   CONCAT(DictKeyGroup, Tkey, Tval)
+#    define Dict_ValueGroup(Tkey, Tval) CONCAT(DictValueGroup, Tkey, Tval)
+#    define Dict_EntryGroup(Tkey, Tval) CONCAT(DictEntryGroup, Tkey, Tval)
+#    define Dict_Entry(Tkey, Tval)      CONCAT(DictEntry, Tkey, Tval)
+#    define Dict_Shard(Tkey, Tval)      CONCAT(DictShard, Tkey, Tval)
 
-static inline uint32_t Dict_HashKey_U32(uint32_t key) {
-    return Dict_Hash32(key);
+// maps a 64-bit hash onto [0, range) by its high bits, without a division
+static inline size_t Dict_FastRange(uint64_t hash, size_t range) {
+    return (size_t)(((__uint128_t)hash * range) >> 64);
 }
 
-static inline uint32_t Dict_HashKey_U64(uint64_t key) {
-    return Dict_Hash32((uint32_t)key) ^ Dict_Hash32((uint32_t)(key >> 32));
+/**
+ * @brief Gets which of @param count partitions (a power of 2) the key with @param hash belongs to, for dicts split
+ * into several tables by hash
+ * @note The partition comes from the hash bits just above the 7-bit tag, a partition's dict picks groups by the high
+ * bits, so the keys of one partition still spread out over its whole table
+ */
+static inline size_t Dict_PartitionIndex(uint64_t hash, size_t count) {
+    return (hash >> 7) & (count - 1);
 }
 
-static inline uint32_t Dict_HashKey_F32(float key) {
-    union {
-        float    f32;
-        uint32_t u32;
-    } conv = {.f32 = key};
-
-    _Static_assert(sizeof(float) == sizeof(uint32_t), "float isn't 32 bits");
-    return Dict_Hash32(conv.u32);
+// spins before a thread waiting on a shard's lock yields its core, in case the holder isn't running
+#    define Dict_Lock_Spins 128
+
+// a test and test-and-set spinlock guarding one shard of a sharded dict, the critical sections are a single dict
+// operation so spinning beats sleeping in the kernel (except for the odd grow)
+static inline void Dict_Lock(uint32_t* lock) {
+    while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE)) {
+        for (int spins = 0; __atomic_load_n(lock, __ATOMIC_RELAXED); spins++) {
+            if (spins < Dict_Lock_Spins) {
+                _mm_pause();
+            } else {
+                sched_yield();
+            }
+        }
+    }
 }
 
-static inline uint32_t Dict_HashKey_F64(double key) {
-    union {
-        double   f64;
-        uint64_t u64;
-    } conv = {.f64 = key};
-
-    _Static_assert(sizeof(double) == sizeof(uint64_t), "double isn't 64 bits");
-    return Dict_HashKey_U64(conv.u64);
+static inline void Dict_Unlock(uint32_t* lock) {
+    __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
 }
 
-static inline uint32_t Dict_HashKey_Str(const char* restrict str) {
-    uint64_t hash = 0xcbf29ce484222325;
+// a reader's slot in a Dict_Rcu, the epoch it started reading in (or 0 while it isn't reading), each slot has its
+// own cache line so readers never write to a line another thread reads or writes
+typedef struct {
+    uint64_t epoch;
+} __attribute__((aligned(64))) Dict_ReaderSlot;
+
+// the slots of a group of an ordered dict, each holds the index of its entry in the dict's entry array
+typedef struct {
+    uint32_t index[16];
+} Dict_IndexGroup;
+
+#    define Dict_Stats_Buckets 16
+
+// counters kept by a dict with Dict_Stats, every probe of the table counts as a lookup, including the ones made
+// by Dict_Set, Dict_Upsert and Dict_Remove
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t hit_groups;  // groups probed by lookups that found their key
+    uint64_t miss_groups; // groups probed by lookups that didn't
+    // lookups by the number of groups they probed, the last bucket also counts every longer probe
+    uint64_t hit_histogram[Dict_Stats_Buckets];
+    uint64_t miss_histogram[Dict_Stats_Buckets];
+    uint64_t tag_matches; // slots checked because their tag matched the key's, every one but a hit is a false positive
+    uint64_t compares;    // key compares, fewer than tag_matches with Dict_CacheHash
+    uint64_t grows;
+    uint64_t rehashes;    // in-place rehashes to clean up tombstones
+    uint64_t grow_cycles; // TSC cycles spent growing and rehashing
+} Dict_Counters;
+
+#    define Dict_File_Magic   "CTLDICT"
+#    define Dict_File_Version 1
+
+// header of a file written by Dict_Save, the table's block follows it laid out as it is in memory, everything but
+// the counts and the seed has to match the instantiation opening the file
+typedef struct {
+    char     magic[8];
+    uint32_t version; // bumped whenever the table layout or the built-in hashes change
+    uint32_t layout;
+    uint32_t probing;
+    uint32_t cache_hash;
+    uint64_t key_size;
+    uint64_t value_size;
+    uint64_t capacity;
+    uint64_t size;
+    uint64_t tombstones;
+    uint64_t seed;
+    uint8_t  reserved[56]; // pads the header to 128 bytes, which keeps the table aligned for SSE loads
+} Dict_FileHeader;
+#endif
 
-    while (*str) {
-        hash ^= *str++;
-        hash *= 0x100000001b3;
-    }
+#if !defined(Dict_KeyType) || !defined(Dict_ValueType)
+#    error "Dict template requires key and value types to be defined"
+#endif
 
-    return (uint32_t)hash ^ (uint32_t)(hash >> 32);
-}
+#if !defined(Dict_Probing)
+#    define Dict_Probing Dict_Probing_Triangular
+#endif
 
-#    endif
+#if !defined(Dict_Layout)
+#    define Dict_Layout Dict_Layout_Split
+#endif
 
-#    define Dict_HashKey(key) \
-        _Generic((key),                   \
-            uint8_t:    Dict_HashKey_U8,  \
-            int8_t:     Dict_HashKey_U8,  \
-            uint16_t:   Dict_HashKey_U16, \
-            int16_t:    Dict_HashKey_U16, \
-            uint32_t:   Dict_HashKey_U32, \
-            int32_t:    Dict_HashKey_U32, \
-            uint64_t:   Dict_HashKey_U64, \
-            int64_t:    Dict_HashKey_U64, \
-            float:      Dict_HashKey_F32, \
-            double:     Dict_HashKey_F64, \
-            char*:      Dict_HashKey_Str)((key))
+#if !defined(Dict_MaxLoad)
+#    define Dict_MaxLoad(capacity) ((capacity) - (capacity) / 8)
 #endif
 
-#if !defined(Dict_CompareKey)
-#    if !defined(CTL_DICT_COMMON_COMPARE)
-#        define CTL_DICT_COMMON_COMPARE
+#if defined(Dict_GrowInPlace) && defined(Dict_Incremental)
+#    error "Dict_GrowInPlace and Dict_Incremental can't be combined"
+#endif
 
-static inline bool Dict_CompareKey_U8(uint8_t k1, uint8_t k2) {
-    return k1 == k2;
-}
+#if defined(Dict_Incremental)
+// an empty definition turns the expression into 0 - - 1
+#    if (0 - Dict_Incremental - 1) == 1
+#        define Dict_MigrateGroups 1
+#    elif (Dict_Incremental + 0) < 1
+#        error "Dict_Incremental must be empty or the number of groups to migrate per operation, at least 1"
+#    else
+#        define Dict_MigrateGroups (Dict_Incremental)
+#    endif
+#endif
 
-static inline bool Dict_CompareKey_U16(uint16_t k1, uint16_t k2) {
-    return k1 == k2;
-}
+#if Dict_Probing != Dict_Probing_Linear && Dict_Probing != Dict_Probing_Triangular && \
+    Dict_Probing != Dict_Probing_Stride
+#    error "Dict_Probing must be one of Dict_Probing_Linear, Dict_Probing_Triangular or Dict_Probing_Stride"
+#endif
 
-static inline bool Dict_CompareKey_U32(uint32_t k1, uint32_t k2) {
-    return k1 == k2;
-}
+#if Dict_Layout != Dict_Layout_Split && Dict_Layout != Dict_Layout_Interleaved && Dict_Layout != Dict_Layout_Ordered
+#    error "Dict_Layout must be one of Dict_Layout_Split, Dict_Layout_Interleaved or Dict_Layout_Ordered"
+#endif
 
-static inline bool Dict_CompareKey_U64(uint64_t k1, uint64_t k2) {
-    return k1 == k2;
-}
+#if Dict_Layout == Dict_Layout_Ordered && \
+    (defined(Dict_Incremental) || defined(Dict_GrowInPlace) || defined(Dict_Inline) || defined(Dict_Mappable))
+#    error "Dict_Layout_Ordered can't be combined with Dict_Incremental, Dict_GrowInPlace, Dict_Inline or Dict_Mappable"
+#endif
 
-static inline bool Dict_CompareKey_F32(float k1, float k2) {
-    return k1 == k2;
-}
+#if defined(Dict_LookupType)
+#    if defined(Dict_HashKey) && !defined(Dict_HashLookup)
+#        error "Dict_LookupType with a custom Dict_HashKey requires Dict_HashLookup"
+#    endif
+#    if defined(Dict_HashLookup) && !defined(Dict_HashKey)
+#        error "Dict_HashLookup requires a custom Dict_HashKey, the built-in key hashes are seeded per dict"
+#    endif
+#    if defined(Dict_CompareKey) && !defined(Dict_CompareLookup)
+#        error "Dict_LookupType with a custom Dict_CompareKey requires Dict_CompareLookup"
+#    endif
+#endif
 
-static inline bool Dict_CompareKey_F64(double k1, double k2) {
-    return k1 == k2;
-}
+// the built-in hashes are already mixed, a custom 64-bit one might not be (see Notes), a custom hash ignores the seed
+#if !defined(Dict_HashKey)
+#    define Dict_HashKeySeeded(key, seed) Dict_HashKey_Builtin(key, seed)
+#    define Dict_MixHash(hash)            (hash)
+#    define Dict_HashUsesSeed             true
+#else
+#    define Dict_HashKeySeeded(key, seed) ((void)(seed), Dict_HashKey(key))
+#    define Dict_MixHash(hash)            Dict_Mix64(hash)
+#    define Dict_HashUsesSeed             false
+#endif
 
-static inline bool Dict_CompareKey_Str(char* k1, char* k2) {
-    return !strcmp(k1, k2);
-}
+#if !defined(Dict_CompareKey)
+// the default compare is plain equality for integer keys, which lets Dict_Find compare whole groups of them at once
+#    define Dict_CompareKey_Default
+#    define Dict_CompareKey(k1, k2) Dict_CompareKey_Builtin(k1, k2)
+#endif
 
+#if defined(Dict_LookupType)
+#    if !defined(Dict_HashLookup)
+#        define Dict_HashLookupSeeded(lookup, seed) Dict_HashKeySeeded(lookup, seed)
+#    else
+#        define Dict_HashLookupSeeded(lookup, seed) ((void)(seed), Dict_HashLookup(lookup))
+#    endif
+#    if !defined(Dict_CompareLookup)
+#        define Dict_CompareLookup(lookup, key) \
+            (_Generic((key), \
+                char*:  Dict_CompareKey_StrViewStr \
+            )((lookup), (key)))
 #    endif
-
-#    define Dict_CompareKey(k1, k2) \
-        (_Generic((k1), \
-            uint8_t:    Dict_CompareKey_U8,  \
-            int8_t:     Dict_CompareKey_U8,  \
-            uint16_t:   Dict_CompareKey_U16, \
-            int16_t:    Dict_CompareKey_U16, \
-            uint32_t:   Dict_CompareKey_U32, \
-            int32_t:    Dict_CompareKey_U32, \
-            uint64_t:   Dict_CompareKey_U64, \
-            int64_t:    Dict_CompareKey_U64, \
-            float:      Dict_CompareKey_F32, \
-            double:     Dict_CompareKey_F64, \
-            char*:      Dict_CompareKey_Str \
-        )((k1), (k2)))
 #endif
 
 #if !defined(Dict_Malloc)
@@ -225,46 +383,43 @@ static inline bool Dict_CompareKey_Str(char* k1, char* k2) {
 #    define Tval_ Dict_ValueType_Alias
 #endif
 
-#if !defined(CTL_DICT_COMMON_TYPES)
-#    define CTL_DICT_COMMON_TYPES
-
-typedef union {
-    __m128d  d128;
-    __m128i  i128;
-    uint64_t u64[2];
-    uint32_t u32[4];
-    uint16_t u16[8];
-    uint8_t  u8[16];
-} Dict_v128;
-
-typedef union {
+#if Dict_Layout == Dict_Layout_Interleaved
+typedef struct Dict_EntryGroup(Tkey_, Tval_) {
     struct {
-        uint8_t hlow     : 7;
-        uint8_t occupied : 1;
-    };
-    uint8_t u8;
-} Dict_Metadata;
-
-typedef union {
-    Dict_Metadata slot[16];
-    Dict_v128     v128;
-} Dict_MetadataGroup;
-
-static inline uint16_t Dict_CompareBitmask(Dict_MetadataGroup metadata, uint8_t expected) {
-    __m128i  exp_vector = _mm_set1_epi8(expected);
-    __m128i  comparison = _mm_cmpeq_epi8(exp_vector, metadata.v128.i128);
-    uint16_t mask       = _mm_movemask_epi8(comparison);
-
-    return mask;
+        Tkey key;
+        Tval val;
+    } entry[16];
 }
-
-static inline uint16_t Dict_OccupiedBitmask(Dict_MetadataGroup metadata) {
-    uint16_t mask = _mm_movemask_epi8(metadata.v128.i128);
-    return mask;
+Dict_EntryGroup(Tkey_, Tval_);
+
+#    define Dict_KeyAt(table, group, slot) ((table)->entry_group[(group)].entry[(slot)].key)
+#    define Dict_ValAt(table, group, slot) ((table)->entry_group[(group)].entry[(slot)].val)
+#    define Dict_KeyGroupStride            sizeof(Dict_EntryGroup(Tkey_, Tval_))
+#    define Dict_ValGroupStride            sizeof(Dict_EntryGroup(Tkey_, Tval_))
+#    define Dict_KeySlotStride             (sizeof(Dict_EntryGroup(Tkey_, Tval_)) / 16)
+#    define Dict_ValSlotStride             (sizeof(Dict_EntryGroup(Tkey_, Tval_)) / 16)
+#    define Dict_GroupSize                 sizeof(Dict_EntryGroup(Tkey_, Tval_))
+#elif Dict_Layout == Dict_Layout_Ordered
+typedef struct Dict_Entry(Tkey_, Tval_) {
+    Tkey key;
+    Tval val;
+#    if defined(Dict_CacheHash)
+    uint64_t hash;
+#    endif
 }
-
-#endif
-
+Dict_Entry(Tkey_, Tval_);
+
+#    define Dict_EntryAt(table, group, slot) ((table)->entry[(table)->index_group[(group)].index[(slot)]])
+#    define Dict_KeyAt(table, group, slot)   (Dict_EntryAt(table, group, slot).key)
+#    define Dict_ValAt(table, group, slot)   (Dict_EntryAt(table, group, slot).val)
+#    define Dict_HashAt(table, group, slot)  (Dict_EntryAt(table, group, slot).hash)
+
+// the entry array has room for one more entry than the max load, an insert appends its entry before the load is
+// checked
+#    define Dict_EntryCapacity(capacity) ((size_t)Dict_MaxLoad(capacity) + 1)
+// words in the bitmap of live entries, kept even so the entries that follow it stay 16 byte aligned
+#    define Dict_LiveWords(capacity) ((Dict_EntryCapacity(capacity) + 127) / 128 * 2)
+#else
 typedef struct Dict_KeyGroup(Tkey_, Tval_) {
     Tkey key[16];
 }
@@ -275,48 +430,281 @@ typedef struct Dict_ValueGroup(Tkey_, Tval_) {
 }
 Dict_ValueGroup(Tkey_, Tval_);
 
+#    define Dict_KeyAt(table, group, slot) ((table)->key_group[(group)].key[(slot)])
+#    define Dict_ValAt(table, group, slot) ((table)->value_group[(group)].val[(slot)])
+#    define Dict_KeyGroupStride            sizeof(Dict_KeyGroup(Tkey_, Tval_))
+#    define Dict_ValGroupStride            sizeof(Dict_ValueGroup(Tkey_, Tval_))
+#    define Dict_KeySlotStride             sizeof(Tkey)
+#    define Dict_ValSlotStride             sizeof(Tval)
+#    define Dict_GroupSize                 (sizeof(Dict_KeyGroup(Tkey_, Tval_)) + sizeof(Dict_ValueGroup(Tkey_, Tval_)))
+#endif
+
+#if Dict_Layout != Dict_Layout_Ordered
+#    define Dict_HashAt(table, group, slot) ((table)->hash[(group) * 16 + (slot)])
+#endif
+
+// integer keys with the default compare are matched against a whole group's keys with SIMD compares instead of one
+// tag match at a time (only the split layout stores a group's keys contiguously), 32-bit keys only with Dict_SimdKeys
+#if Dict_Layout == Dict_Layout_Split && defined(Dict_CompareKey_Default) && defined(Dict_SimdKeys)
+#    define Dict_MatchKeys \
+        _Generic((Tkey){0}, \
+            uint8_t:  true, \
+            int8_t:   true, \
+            uint16_t: true, \
+            int16_t:  true, \
+            uint32_t: true, \
+            int32_t:  true, \
+            default:  false)
+#elif Dict_Layout == Dict_Layout_Split && defined(Dict_CompareKey_Default)
+#    define Dict_MatchKeys \
+        _Generic((Tkey){0}, \
+            uint8_t:  true, \
+            int8_t:   true, \
+            uint16_t: true, \
+            int16_t:  true, \
+            default:  false)
+#else
+#    define Dict_MatchKeys false
+#endif
+
+#if defined(Dict_Stats)
+#    define Dict_StatsAdd(dict, counter, amount) ((dict)->stats.counter += (amount))
+#else
+#    define Dict_StatsAdd(dict, counter, amount) ((void)0)
+#endif
+
 typedef struct Dict(Tkey_, Tval_) {
     size_t capacity;
     size_t size;
+    size_t tombstones;
+    // mixed into the built-in key hashes, entries are placed by seeded hashes so it can't change once there are any
+    uint64_t seed;
+#if Dict_Layout == Dict_Layout_Interleaved
+    Dict_EntryGroup(Tkey_, Tval_) * entry_group;
+#elif Dict_Layout == Dict_Layout_Ordered
+    Dict_IndexGroup* index_group;
+    Dict_Entry(Tkey_, Tval_) * entry;
+    uint64_t* live;        // a bit per entry, cleared when the entry is removed
+    size_t    entry_count; // entries appended since the entry array was last compacted, including removed ones
+#else
     Dict_KeyGroup(Tkey_, Tval_) * key_group;
     Dict_ValueGroup(Tkey_, Tval_) * value_group;
+#endif
     Dict_MetadataGroup* metadata_group;
+#if defined(Dict_CacheHash) && Dict_Layout != Dict_Layout_Ordered
+    uint64_t* hash;
+#endif
+#if defined(Dict_Incremental)
+    // the table being migrated away from, old_capacity is 0 when there's no migration running
+    size_t old_capacity;
+    size_t old_size;
+    size_t migrate_index;
+#    if Dict_Layout == Dict_Layout_Interleaved
+    Dict_EntryGroup(Tkey_, Tval_) * old_entry_group;
+#    else
+    Dict_KeyGroup(Tkey_, Tval_) * old_key_group;
+    Dict_ValueGroup(Tkey_, Tval_) * old_value_group;
+#    endif
+    Dict_MetadataGroup* old_metadata_group;
+#    if defined(Dict_CacheHash)
+    uint64_t* old_hash;
+#    endif
+#endif
+#if defined(Dict_Stats)
+    Dict_Counters stats;
+#endif
+#if defined(Dict_Mappable)
+    // the file mapping the table lives in if the dict was opened with Dict_MapFile, NULL otherwise
+    void*  mapping;
+    size_t mapping_size;
+#endif
+#if defined(Dict_Inline)
+    // storage for a single group table, used instead of a heap allocation until the dict grows past 16 slots
+    Dict_MetadataGroup inline_metadata_group;
+#    if Dict_Layout == Dict_Layout_Interleaved
+    Dict_EntryGroup(Tkey_, Tval_) inline_entry_group;
+#    else
+    Dict_KeyGroup(Tkey_, Tval_) inline_key_group;
+    Dict_ValueGroup(Tkey_, Tval_) inline_value_group;
+#    endif
+#    if defined(Dict_CacheHash)
+    uint64_t inline_hash[16];
+#    endif
+#endif
 }
 Dict(Tkey_, Tval_);
 
 CTL_OVERLOADABLE
 static inline bool Dict_Grow(Dict(Tkey_, Tval_) * dict);
 
+CTL_OVERLOADABLE
+static inline void Dict_Rehash(Dict(Tkey_, Tval_) * dict);
+
+CTL_OVERLOADABLE
+static inline bool Dict_Reserve(Dict(Tkey_, Tval_) * dict, size_t count);
+
+CTL_OVERLOADABLE
+static inline void Dict_RemoveSlot(Dict(Tkey_, Tval_) * dict, size_t group_index, size_t slot_index);
+
 /**
- * @brief Initializes a dict for use
+ * @brief Checks if the dict's table is its inline group rather than a heap allocation
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_IsInline(Dict(Tkey_, Tval_) * dict) {
+#if defined(Dict_Inline)
+    return dict->metadata_group == &dict->inline_metadata_group;
+#else
+    (void)dict;
+    return false;
+#endif
+}
+
+/**
+ * @brief Points the dict's table at its inline group
+ */
+CTL_OVERLOADABLE
+static inline void Dict_UseInline(Dict(Tkey_, Tval_) * dict) {
+#if defined(Dict_Inline)
+    dict->metadata_group = &dict->inline_metadata_group;
+#    if Dict_Layout == Dict_Layout_Interleaved
+    dict->entry_group = &dict->inline_entry_group;
+#    else
+    dict->key_group   = &dict->inline_key_group;
+    dict->value_group = &dict->inline_value_group;
+#    endif
+#    if defined(Dict_CacheHash)
+    dict->hash = dict->inline_hash;
+#    endif
+#else
+    (void)dict;
+#endif
+}
+
+/**
+ * @brief Copies the dict struct @param src to @param dst, re-pointing the table at @param dst's own inline group if
+ * @param src was using its inline group
+ */
+CTL_OVERLOADABLE
+static inline void Dict_Assign(Dict(Tkey_, Tval_) * dst, Dict(Tkey_, Tval_) * src) {
+    bool is_inline = Dict_IsInline(src);
+
+    *dst = *src;
+    if (is_inline) {
+        Dict_UseInline(dst);
+    }
+}
+
+/**
+ * @brief Gets the size of the block holding a table with @param capacity slots
+ * @note The dict is only used to select the instantiation
+ */
+CTL_OVERLOADABLE
+static inline size_t Dict_TableSize(Dict(Tkey_, Tval_) * dict, size_t capacity) {
+    (void)dict;
+
+#if Dict_Layout == Dict_Layout_Ordered
+    return capacity / 16 * (sizeof(Dict_MetadataGroup) + sizeof(Dict_IndexGroup)) +
+           Dict_LiveWords(capacity) * sizeof(uint64_t) +
+           Dict_EntryCapacity(capacity) * sizeof(Dict_Entry(Tkey_, Tval_));
+#else
+#    if defined(Dict_CacheHash)
+    size_t hash_size = capacity * sizeof(uint64_t);
+#    else
+    size_t hash_size = 0;
+#    endif
+
+    return capacity / 16 * (sizeof(Dict_MetadataGroup) + Dict_GroupSize) + hash_size;
+#endif
+}
+
+/**
+ * @brief Points the dict's arrays into @param block, laid out as the metadata, then the entries, then the hashes for
+ * the dict's capacity. An ordered dict's block is the metadata, the index, the live entry bitmap and then the entries
+ */
+CTL_OVERLOADABLE
+static inline void Dict_SetTable(Dict(Tkey_, Tval_) * dict, void* block) {
+    size_t group_count         = dict->capacity / 16;
+    size_t metadata_group_size = group_count * sizeof(Dict_MetadataGroup);
+
+    dict->metadata_group = block;
+#if Dict_Layout == Dict_Layout_Interleaved
+    dict->entry_group = block + metadata_group_size;
+#elif Dict_Layout == Dict_Layout_Ordered
+    size_t index_group_size = group_count * sizeof(Dict_IndexGroup);
+
+    dict->index_group = block + metadata_group_size;
+    dict->live        = block + metadata_group_size + index_group_size;
+    dict->entry = block + metadata_group_size + index_group_size + Dict_LiveWords(dict->capacity) * sizeof(uint64_t);
+#else
+    dict->key_group   = block + metadata_group_size;
+    dict->value_group = block + metadata_group_size + group_count * sizeof(Dict_KeyGroup(Tkey_, Tval_));
+#endif
+#if defined(Dict_CacheHash) && Dict_Layout != Dict_Layout_Ordered
+    dict->hash = block + metadata_group_size + group_count * Dict_GroupSize;
+#endif
+}
+
+/**
+ * @brief Initializes a dict for use with a given hash seed
  * @param dict A pointer to the dict to initialize
  * @param capacity The initial capacity of the dict
+ * @param seed The seed mixed into the built-in key hashes, a fixed seed makes the layout reproducible (and
+ * predictable to whoever supplies the keys)
  * @return True if the initialization succeeded, false otherwise
  * @note If capacity is not of the form 2^N * 16, it is rounded up to the next suitable form (e.g. 0 -> 16,
  * 17 -> 32, etc)
  */
 CTL_OVERLOADABLE
-static inline bool Dict_Init(Dict(Tkey_, Tval_) * dict, size_t capacity) {
-    dict->capacity = 16 * CTL_NEXT_POW2(capacity / 16);
-    dict->size     = 0;
+static inline bool Dict_InitWithSeed(Dict(Tkey_, Tval_) * dict, size_t capacity, uint64_t seed) {
+    dict->capacity   = 16 * CTL_NEXT_POW2(capacity / 16);
+    dict->size       = 0;
+    dict->tombstones = 0;
+    dict->seed       = seed;
+
+#if Dict_Layout == Dict_Layout_Ordered
+    dict->entry_count = 0;
+#endif
+#if defined(Dict_Incremental)
+    dict->old_capacity = 0;
+#endif
+#if defined(Dict_Stats)
+    memset(&dict->stats, 0, sizeof(dict->stats));
+#endif
+#if defined(Dict_Mappable)
+    dict->mapping = NULL;
+#endif
 
-    size_t group_count         = dict->capacity / 16;
-    size_t metadata_group_size = group_count * sizeof(Dict_MetadataGroup);
-    size_t key_group_size      = group_count * sizeof(Dict_KeyGroup(Tkey_, Tval_));
-    size_t value_group_size    = group_count * sizeof(Dict_ValueGroup(Tkey_, Tval_));
+#if defined(Dict_Inline)
+    if (dict->capacity == 16) {
+        Dict_UseInline(dict);
+        memset(&dict->inline_metadata_group, 0, sizeof(dict->inline_metadata_group));
+        return true;
+    }
+#endif
 
-    void* block = Dict_Malloc(metadata_group_size + key_group_size + value_group_size);
+    void* block = Dict_Malloc(Dict_TableSize(dict, dict->capacity));
     if (block == NULL) {
         return false;
     }
 
-    dict->metadata_group = block;
-    dict->key_group      = block + metadata_group_size;
-    dict->value_group    = block + metadata_group_size + key_group_size;
-
+    Dict_SetTable(dict, block);
     return true;
 }
 
+/**
+ * @brief Initializes a dict for use
+ * @param dict A pointer to the dict to initialize
+ * @param capacity The initial capacity of the dict
+ * @return True if the initialization succeeded, false otherwise
+ * @note If capacity is not of the form 2^N * 16, it is rounded up to the next suitable form (e.g. 0 -> 16,
+ * 17 -> 32, etc)
+ * @note The dict gets a random hash seed, so keys can't be chosen ahead of time to all collide in it
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Init(Dict(Tkey_, Tval_) * dict, size_t capacity) {
+    return Dict_InitWithSeed(dict, capacity, Dict_RandomSeed(dict));
+}
+
 /**
  * @brief Allocates and initializes a dict on the heap
  * @param capacity The initial capacity of the dict
@@ -341,7 +729,26 @@ static inline Dict(Tkey_, Tval_) * Dict_New(Tkey_, Tval_)(size_t capacity) {
  */
 CTL_OVERLOADABLE
 static inline void Dict_Uninit(Dict(Tkey_, Tval_) * dict) {
-    Dict_Free(dict->metadata_group);
+#if defined(Dict_Incremental)
+    if (dict->old_capacity != 0) {
+        Dict_Free(dict->old_metadata_group);
+        dict->old_capacity = 0;
+    }
+#endif
+
+#if defined(Dict_Mappable)
+    if (dict->mapping != NULL) {
+        munmap(dict->mapping, dict->mapping_size);
+        dict->mapping        = NULL;
+        dict->metadata_group = NULL;
+        return;
+    }
+#endif
+
+    if (!Dict_IsInline(dict)) {
+        Dict_Free(dict->metadata_group);
+    }
+
     dict->metadata_group = NULL;
 }
 
@@ -356,68 +763,585 @@ static inline void Dict_Delete(Dict(Tkey_, Tval_) * dict) {
     Dict_Free(dict);
 }
 
+/**
+ * @brief Computes the hash the dict uses for @param key
+ * @param dict The dictionary the hash is for
+ * @param key The key to hash
+ * @return The 64-bit hash of @param key, hashes from a custom Dict_HashKey are mixed (64-bit) or widened (narrower)
+ */
+CTL_OVERLOADABLE
+static inline uint64_t Dict_Hash(Dict(Tkey_, Tval_) * dict, Tkey key) {
+    if (sizeof(Dict_HashKeySeeded(key, dict->seed)) >= sizeof(uint64_t)) {
+        return Dict_MixHash(Dict_HashKeySeeded(key, dict->seed));
+    } else {
+        return Dict_WidenHash(Dict_HashKeySeeded(key, dict->seed));
+    }
+}
+
+/**
+ * @brief Starts the probe sequence for @param hash in a table of @param group_count groups
+ * @note The dict is only used to select the instantiation's probing policy
+ */
+CTL_OVERLOADABLE
+static inline Dict_Probe Dict_ProbeStart(Dict(Tkey_, Tval_) * dict, uint64_t hash, size_t group_count) {
+    (void)dict;
+    return Dict_StartProbe(Dict_Probing, hash, group_count);
+}
+
+/**
+ * @brief Advances @param probe to the next group in its probe sequence (see @ref Dict_NextProbe)
+ * @note The dict is only used to select the instantiation's probing policy
+ */
+CTL_OVERLOADABLE
+static inline void Dict_ProbeNext(Dict(Tkey_, Tval_) * dict, Dict_Probe* probe) {
+    (void)dict;
+    Dict_NextProbe(Dict_Probing, probe);
+}
+
+/**
+ * @brief Gets the hash of the entry in a slot, from the cached hashes if the dict keeps them
+ */
+CTL_OVERLOADABLE
+static inline uint64_t Dict_SlotHash(Dict(Tkey_, Tval_) * dict, size_t group_index, size_t slot_index) {
+#if defined(Dict_CacheHash)
+    return Dict_HashAt(dict, group_index, slot_index);
+#else
+    return Dict_Hash(dict, Dict_KeyAt(dict, group_index, slot_index));
+#endif
+}
+
+/**
+ * @brief Checks @param hash against a slot's cached hash before paying for a key compare, always true if the dict
+ * doesn't keep hashes
+ */
+CTL_OVERLOADABLE
+static inline bool
+Dict_SlotHashMatches(Dict(Tkey_, Tval_) * dict, size_t group_index, size_t slot_index, uint64_t hash) {
+#if defined(Dict_CacheHash)
+    return Dict_HashAt(dict, group_index, slot_index) == hash;
+#else
+    (void)dict;
+    (void)group_index;
+    (void)slot_index;
+    (void)hash;
+    return true;
+#endif
+}
+
+/**
+ * @brief Compares @param key against all 16 keys of a group at once, only used if Dict_MatchKeys
+ * @return A mask of the group's slots holding @param key, see @ref Dict_KeyGroupBitmask
+ */
+CTL_OVERLOADABLE
+static inline uint16_t Dict_KeyBitmask(Dict(Tkey_, Tval_) * dict, size_t group_index, Tkey key) {
+#if Dict_Layout == Dict_Layout_Split
+    return Dict_KeyGroupBitmask(&dict->key_group[group_index], sizeof(Tkey), &key);
+#else
+    (void)dict;
+    (void)group_index;
+    (void)key;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Counts a lookup that probed @param groups groups and either found its key or didn't, a no-op without
+ * Dict_Stats
+ */
+CTL_OVERLOADABLE
+static inline void Dict_RecordLookup(Dict(Tkey_, Tval_) * dict, size_t groups, bool found) {
+#if defined(Dict_Stats)
+    size_t bucket = groups < Dict_Stats_Buckets ? groups - 1 : Dict_Stats_Buckets - 1;
+    if (found) {
+        dict->stats.hits += 1;
+        dict->stats.hit_groups += groups;
+        dict->stats.hit_histogram[bucket] += 1;
+    } else {
+        dict->stats.misses += 1;
+        dict->stats.miss_groups += groups;
+        dict->stats.miss_histogram[bucket] += 1;
+    }
+#else
+    (void)dict;
+    (void)groups;
+    (void)found;
+#endif
+}
+
 CTL_OVERLOADABLE
 static inline bool
-Dict_Find(Dict(Tkey_, Tval_) * dict, Tkey key, uint32_t hash, size_t* group_index_out, size_t* slot_index_out) {
-    size_t        group_index       = hash & (dict->capacity / 16 - 1);
-    Dict_Metadata expected_metadata = {.hlow = hash, .occupied = true};
+Dict_Find(Dict(Tkey_, Tval_) * dict, Tkey key, uint64_t hash, size_t* group_index_out, size_t* slot_index_out) {
+    Dict_Probe    probe             = Dict_ProbeStart(dict, hash, dict->capacity / 16);
+    Dict_Metadata expected_metadata = Dict_OccupiedMetadata(hash);
+
+    // the first unoccupied (empty or deleted) slot on the probe sequence, where the key would be inserted
+    bool   found_available = false;
+    size_t available_group = 0;
+    int    available_slot  = 0;
+    size_t groups          = 1;
 
     // look through the dict for a match
     // NOTE: we don't bother to provide a termination condition because the table should always have an
     // empty entry
     while (true) {
+        size_t group_index = probe.index;
+
         // compare a group at a time via SIMD (16 in one go)
         uint16_t mask = Dict_CompareBitmask(dict->metadata_group[group_index], expected_metadata.u8);
 
+        // for integer keys the tags only rule out groups without a candidate (so a miss doesn't touch the keys), the
+        // candidates' keys are then compared all at once, the one left (if any) is the hit
+        if (Dict_MatchKeys && mask != 0) {
+            Dict_StatsAdd(dict, tag_matches, __builtin_popcount(mask));
+            Dict_StatsAdd(dict, compares, 1);
+
+            mask &= Dict_KeyBitmask(dict, group_index, key);
+            if (mask != 0) {
+                Dict_RecordLookup(dict, groups, true);
+                *group_index_out = group_index;
+                *slot_index_out  = __builtin_ctz(mask);
+                return true;
+            }
+        }
+
         // if bits are set in the mask, check each of the set bit positions (corresponding to positions in
         // the group)
         for (int imask = mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
             bitpos = ffs(imask) - 1;
-            if (Dict_CompareKey(key, dict->key_group[group_index].key[bitpos])) {
+            Dict_StatsAdd(dict, tag_matches, 1);
+            if (!Dict_SlotHashMatches(dict, group_index, bitpos, hash)) {
+                continue;
+            }
+
+            Dict_StatsAdd(dict, compares, 1);
+            if (Dict_CompareKey(key, Dict_KeyAt(dict, group_index, bitpos))) {
+                Dict_RecordLookup(dict, groups, true);
                 *group_index_out = group_index;
                 *slot_index_out  = bitpos;
                 return true;
             }
         }
 
-        // if any were unoccupied, the entry must not be present in the dictionary
         uint16_t occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
-        if (occupied_mask != 0xFFFF) {
-            *group_index_out = group_index;
-            *slot_index_out  = occupied_mask;
+        if (!found_available && occupied_mask != 0xFFFF) {
+            found_available = true;
+            available_group = group_index;
+            available_slot  = ffs(~occupied_mask) - 1;
+        }
+
+        // if any were empty, the entry must not be present in the dictionary, deleted slots don't end the probe
+        // since the key may have been placed after the slot was occupied
+        if (Dict_EmptyBitmask(dict->metadata_group[group_index])) {
+            Dict_RecordLookup(dict, groups, false);
+            *group_index_out = available_group;
+            *slot_index_out  = available_slot;
             return false;
         }
 
         // go to next group
-        // TODO: quadratic probing? might be better
-        group_index = (group_index + 1) & (dict->capacity / 16 - 1);
+        Dict_ProbeNext(dict, &probe);
+        groups += 1;
     }
 }
 
 /**
- * @brief Looks up a value given a key, returns true if the key was found, false otherwise
- * @param dict The dictionary to search for the key
- * @param key The key to look for
- * @param out_val A pointer to where to write the value found at @param key, if found
- * @return True if @param key was found and the value was written to @param out_val, false otherwise
+ * @brief Places an entry known not to be in the dict into the first unoccupied slot on its probe sequence, without
+ * comparing keys or checking if the dict needs to grow
+ * @note Doesn't adjust the dict's size, the caller is moving entries around rather than adding them
  */
 CTL_OVERLOADABLE
-static inline bool Dict_Get(Dict(Tkey_, Tval_) * dict, Tkey key, Tval* out_val) {
-    uint32_t hash = Dict_HashKey(key);
-    size_t   group_index, slot_index;
-    if (Dict_Find(dict, key, hash, &group_index, &slot_index)) {
-        *out_val = dict->value_group[group_index].val[slot_index];
-        return true;
+static inline void Dict_PlaceEntry(Dict(Tkey_, Tval_) * dict, Tkey key, uint64_t hash, Tval val) {
+    Dict_Probe probe = Dict_ProbeStart(dict, hash, dict->capacity / 16);
+    uint16_t   occupied_mask;
+    while ((occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[probe.index])) == 0xFFFF) {
+        Dict_ProbeNext(dict, &probe);
     }
 
-    return false;
+    size_t group_index = probe.index;
+    int    slot_index  = ffs(~occupied_mask) - 1;
+
+    if (dict->metadata_group[group_index].slot[slot_index].u8 == Dict_Metadata_Deleted) {
+        dict->tombstones -= 1;
+    }
+
+    Dict_KeyAt(dict, group_index, slot_index)          = key;
+    Dict_ValAt(dict, group_index, slot_index)          = val;
+    dict->metadata_group[group_index].slot[slot_index] = Dict_OccupiedMetadata(hash);
+#if defined(Dict_CacheHash)
+    Dict_HashAt(dict, group_index, slot_index) = hash;
+#endif
 }
 
+#if defined(Dict_Incremental)
 /**
- * @brief Stores a <key, value> pair to the dictionary, replacing existing instances if present
- * @param dict The dictionary to store to
- * @param key The key to act as the unique identifier for the value
- * @param val The value to store associated with key
+ * @brief Gets a view of the table being migrated away from that the regular table functions can operate on
+ */
+CTL_OVERLOADABLE
+static inline Dict(Tkey_, Tval_) Dict_OldTable(Dict(Tkey_, Tval_) * dict) {
+    Dict(Tkey_, Tval_) old = {
+        .capacity       = dict->old_capacity,
+        .size           = dict->old_size,
+        .seed           = dict->seed,
+        .metadata_group = dict->old_metadata_group,
+#    if Dict_Layout == Dict_Layout_Interleaved
+        .entry_group = dict->old_entry_group,
+#    else
+        .key_group   = dict->old_key_group,
+        .value_group = dict->old_value_group,
+#    endif
+#    if defined(Dict_CacheHash)
+        .hash = dict->old_hash,
+#    endif
+    };
+
+    return old;
+}
+
+/**
+ * @brief Moves up to @param group_count groups of the old table into the current one, freeing the old table once
+ * it's been emptied
+ */
+CTL_OVERLOADABLE
+static inline void Dict_Migrate(Dict(Tkey_, Tval_) * dict, size_t group_count) {
+    Dict(Tkey_, Tval_) old = Dict_OldTable(dict);
+
+    const size_t max_group_index = old.capacity / 16;
+    const size_t end_group_index = dict->migrate_index + CTL_MIN(group_count, max_group_index - dict->migrate_index);
+
+    for (size_t group_index = dict->migrate_index; group_index < end_group_index; group_index++) {
+        uint16_t occupied_mask = Dict_OccupiedBitmask(old.metadata_group[group_index]);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+            Dict_PlaceEntry(
+                dict,
+                Dict_KeyAt(&old, group_index, bitpos),
+                Dict_SlotHash(&old, group_index, bitpos),
+                Dict_ValAt(&old, group_index, bitpos));
+
+            // leave a tombstone so lookups for entries that haven't been migrated yet still probe past this group
+            old.metadata_group[group_index].slot[bitpos].u8 = Dict_Metadata_Deleted;
+            dict->old_size -= 1;
+        }
+    }
+
+    dict->migrate_index = end_group_index;
+
+    if (dict->migrate_index == max_group_index) {
+        Dict_Free(dict->old_metadata_group);
+        dict->old_capacity = 0;
+    }
+}
+#endif
+
+/**
+ * @brief Does a bounded amount of migration work if an incremental grow is running
+ */
+CTL_OVERLOADABLE
+static inline void Dict_MigrateStep(Dict(Tkey_, Tval_) * dict) {
+#if defined(Dict_Incremental)
+    if (dict->old_capacity != 0) {
+        Dict_Migrate(dict, Dict_MigrateGroups);
+    }
+#else
+    (void)dict;
+#endif
+}
+
+/**
+ * @brief Finishes any running incremental grow, functions that walk the whole table call this first
+ */
+CTL_OVERLOADABLE
+static inline void Dict_FinishMigration(Dict(Tkey_, Tval_) * dict) {
+#if defined(Dict_Incremental)
+    if (dict->old_capacity != 0) {
+        Dict_Migrate(dict, SIZE_MAX);
+    }
+#else
+    (void)dict;
+#endif
+}
+
+/**
+ * @brief Looks for @param key in the table being migrated away from, if there is one
+ * @return A pointer to the key's value in the old table, or NULL if it isn't there
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_FindOld(Dict(Tkey_, Tval_) * dict, Tkey key, uint64_t hash) {
+#if defined(Dict_Incremental)
+    if (dict->old_capacity != 0) {
+        Dict(Tkey_, Tval_) old = Dict_OldTable(dict);
+        size_t group_index, slot_index;
+        if (Dict_Find(&old, key, hash, &group_index, &slot_index)) {
+            return &Dict_ValAt(&old, group_index, slot_index);
+        }
+    }
+#else
+    (void)dict;
+    (void)key;
+    (void)hash;
+#endif
+
+    return NULL;
+}
+
+/**
+ * @brief Looks for @param key in the dict, including the table being migrated away from if there is one
+ * @return A pointer to the key's value, or NULL if it isn't in the dict
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_FindValue(Dict(Tkey_, Tval_) * dict, Tkey key, uint64_t hash) {
+    size_t group_index, slot_index;
+    if (Dict_Find(dict, key, hash, &group_index, &slot_index)) {
+        return &Dict_ValAt(dict, group_index, slot_index);
+    }
+
+    return Dict_FindOld(dict, key, hash);
+}
+
+/**
+ * @brief Looks up a pointer to the value stored for a key
+ * @param dict The dictionary to search for the key
+ * @param key The key to look for
+ * @return A pointer to the value stored for @param key, or NULL if @param key isn't in the dict
+ * @warning The pointer is invalidated by anything that adds or removes entries (the entry may move when the dict
+ * grows or rehashes), with Dict_Incremental any Dict_Get/Dict_Set/Dict_Remove can move it as well
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_GetPtr(Dict(Tkey_, Tval_) * dict, Tkey key) {
+    Dict_MigrateStep(dict);
+
+    return Dict_FindValue(dict, key, Dict_Hash(dict, key));
+}
+
+/**
+ * @brief Looks up a value given a key, returns true if the key was found, false otherwise
+ * @param dict The dictionary to search for the key
+ * @param key The key to look for
+ * @param out_val A pointer to where to write the value found at @param key, if found
+ * @return True if @param key was found and the value was written to @param out_val, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Get(Dict(Tkey_, Tval_) * dict, Tkey key, Tval* out_val) {
+    Tval* val = Dict_GetPtr(dict, key);
+    if (val != NULL) {
+        *out_val = *val;
+        return true;
+    }
+
+    return false;
+}
+
+#if defined(Dict_LookupType)
+CTL_OVERLOADABLE
+static inline uint64_t Dict_Hash(Dict(Tkey_, Tval_) * dict, Dict_LookupType lookup) {
+    if (sizeof(Dict_HashLookupSeeded(lookup, dict->seed)) >= sizeof(uint64_t)) {
+        return Dict_MixHash(Dict_HashLookupSeeded(lookup, dict->seed));
+    } else {
+        return Dict_WidenHash(Dict_HashLookupSeeded(lookup, dict->seed));
+    }
+}
+
+CTL_OVERLOADABLE
+static inline bool Dict_FindLookup(
+    Dict(Tkey_, Tval_) * dict,
+    Dict_LookupType lookup,
+    uint64_t        hash,
+    size_t*         group_index_out,
+    size_t*         slot_index_out) {
+    Dict_Probe    probe             = Dict_ProbeStart(dict, hash, dict->capacity / 16);
+    Dict_Metadata expected_metadata = Dict_OccupiedMetadata(hash);
+
+    size_t        groups            = 1;
+
+    while (true) {
+        size_t   group_index = probe.index;
+        uint16_t mask        = Dict_CompareBitmask(dict->metadata_group[group_index], expected_metadata.u8);
+
+        for (int imask = mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+            Dict_StatsAdd(dict, tag_matches, 1);
+            if (!Dict_SlotHashMatches(dict, group_index, bitpos, hash)) {
+                continue;
+            }
+
+            Dict_StatsAdd(dict, compares, 1);
+            if (Dict_CompareLookup(lookup, Dict_KeyAt(dict, group_index, bitpos))) {
+                Dict_RecordLookup(dict, groups, true);
+                *group_index_out = group_index;
+                *slot_index_out  = bitpos;
+                return true;
+            }
+        }
+
+        if (Dict_EmptyBitmask(dict->metadata_group[group_index])) {
+            Dict_RecordLookup(dict, groups, false);
+            return false;
+        }
+
+        Dict_ProbeNext(dict, &probe);
+        groups += 1;
+    }
+}
+
+/**
+ * @brief Looks up a pointer to the value stored for something comparable to a key, see @ref Dict_GetPtr
+ * @param dict The dictionary to search for the key
+ * @param lookup The lookup to look for
+ * @return A pointer to the value stored for the key matching @param lookup, or NULL if there isn't one
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_GetPtr(Dict(Tkey_, Tval_) * dict, Dict_LookupType lookup) {
+    Dict_MigrateStep(dict);
+
+    uint64_t hash = Dict_Hash(dict, lookup);
+    size_t   group_index, slot_index;
+    if (Dict_FindLookup(dict, lookup, hash, &group_index, &slot_index)) {
+        return &Dict_ValAt(dict, group_index, slot_index);
+    }
+
+#    if defined(Dict_Incremental)
+    if (dict->old_capacity != 0) {
+        Dict(Tkey_, Tval_) old = Dict_OldTable(dict);
+        if (Dict_FindLookup(&old, lookup, hash, &group_index, &slot_index)) {
+            return &Dict_ValAt(&old, group_index, slot_index);
+        }
+    }
+#    endif
+
+    return NULL;
+}
+
+/**
+ * @brief Looks up a value by something comparable to a key without having to construct the key (e.g. a
+ * Dict_StrView into a buffer for a dict with char* keys)
+ * @param dict The dictionary to search for the key
+ * @param lookup The lookup to look for
+ * @param out_val A pointer to where to write the value found at @param lookup, if found
+ * @return True if a key matching @param lookup was found and the value was written to @param out_val, false
+ * otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Get(Dict(Tkey_, Tval_) * dict, Dict_LookupType lookup, Tval* out_val) {
+    Tval* val = Dict_GetPtr(dict, lookup);
+    if (val != NULL) {
+        *out_val = *val;
+        return true;
+    }
+
+    return false;
+}
+#endif
+
+/**
+ * @brief Stores a new key in the unoccupied slot Dict_Find returned for it (which may be a tombstone being reused),
+ * the caller stores the value
+ */
+CTL_OVERLOADABLE
+static inline void
+Dict_InsertSlot(Dict(Tkey_, Tval_) * dict, Tkey key, uint64_t hash, size_t group_index, size_t slot_index) {
+    if (dict->metadata_group[group_index].slot[slot_index].u8 == Dict_Metadata_Deleted) {
+        dict->tombstones -= 1;
+    }
+
+#if Dict_Layout == Dict_Layout_Ordered
+    // the entry is appended to the entry array, the slot only holds its index
+    size_t entry_index                               = dict->entry_count++;
+    dict->index_group[group_index].index[slot_index] = (uint32_t)entry_index;
+    dict->live[entry_index / 64] |= 1ull << (entry_index % 64);
+#endif
+
+    Dict_KeyAt(dict, group_index, slot_index) = key;
+#if defined(Dict_CacheHash)
+    Dict_HashAt(dict, group_index, slot_index) = hash;
+#endif
+
+    dict->metadata_group[group_index].slot[slot_index] = Dict_OccupiedMetadata(hash);
+    dict->size += 1;
+}
+
+/**
+ * @brief Gets how full the dict's table is for deciding when it needs to grow, its entries and tombstones. An
+ * ordered dict counts every entry in its entry array, removed ones take up room there until it's compacted, plus
+ * its tombstones, which removing the last entry leaves in the index without leaving a hole in the entry array
+ */
+CTL_OVERLOADABLE
+static inline size_t Dict_Load(Dict(Tkey_, Tval_) * dict) {
+#if Dict_Layout == Dict_Layout_Ordered
+    return dict->entry_count + dict->tombstones;
+#else
+    return dict->size + dict->tombstones;
+#endif
+}
+
+/**
+ * @brief Grows or rehashes the dict if it's gone over its max load
+ * @return True if the dict is within its max load, false if growing it failed
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_CheckLoad(Dict(Tkey_, Tval_) * dict) {
+    if (Dict_Load(dict) <= Dict_MaxLoad(dict->capacity)) {
+        return true;
+    }
+
+    // a migration still running here couldn't keep up with inserts, size counts the entries still in the old table
+    Dict_FinishMigration(dict);
+
+#if defined(Dict_Stats)
+    uint64_t start = __rdtsc();
+#endif
+    if (2 * dict->size <= Dict_MaxLoad(dict->capacity)) {
+        // mostly tombstones, cleaning them up frees enough space without growing
+        Dict_Rehash(dict);
+        Dict_StatsAdd(dict, rehashes, 1);
+    } else if (!Dict_Grow(dict)) {
+        // Growth allocation failed
+        return false;
+    } else {
+        Dict_StatsAdd(dict, grows, 1);
+    }
+    Dict_StatsAdd(dict, grow_cycles, __rdtsc() - start);
+
+    return true;
+}
+
+/**
+ * @brief Stores a <key, value> pair given the key's precomputed hash (from @ref Dict_Hash)
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_SetHashed(Dict(Tkey_, Tval_) * dict, Tkey key, uint64_t hash, Tval val) {
+    Dict_MigrateStep(dict);
+
+    size_t group_index, slot_index;
+    Tval*  old_val;
+    if (Dict_Find(dict, key, hash, &group_index, &slot_index)) {
+        // key was found in the dict already, overwrite the value
+        // TODO: should we overwrite the key? e.g. char* identical strings in different memory locations?
+        Dict_ValAt(dict, group_index, slot_index) = val;
+    } else if ((old_val = Dict_FindOld(dict, key, hash)) != NULL) {
+        // key hasn't been migrated yet, it'll carry the new value with it
+        *old_val = val;
+    } else {
+        // key was not found in the dict already, we get the first unoccupied slot on its probe sequence
+        Dict_InsertSlot(dict, key, hash, group_index, slot_index);
+        Dict_ValAt(dict, group_index, slot_index) = val;
+
+        if (!Dict_CheckLoad(dict)) {
+            // growing failed, take the entry back out rather than leave the dict over its max load (an ordered
+            // dict's entry array has no room for another entry past it)
+            Dict_RemoveSlot(dict, group_index, slot_index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Stores a <key, value> pair to the dictionary, replacing existing instances if present
+ * @param dict The dictionary to store to
+ * @param key The key to act as the unique identifier for the value
+ * @param val The value to store associated with key
  * @return True if the <key, value> pair was inserted successfully, false otherwise
  * @warning Current behavior is to not overwrite the key, this can have implications if two separate key
  * allocations with identical hashes are used and the dict is used as a way to track these allocations (e.g.
@@ -425,29 +1349,1383 @@ static inline bool Dict_Get(Dict(Tkey_, Tval_) * dict, Tkey key, Tval* out_val)
  * un-free'd would be a leak)
  */
 CTL_OVERLOADABLE
-static inline bool Dict_Set(Dict(Tkey_, Tval_) * dict, Tkey key, Tval val) {
-    uint32_t hash = Dict_HashKey(key);
-    size_t   group_index, slot_index;
-    if (Dict_Find(dict, key, hash, &group_index, &slot_index)) {
-        // key was found in the dict already, overwrite the value
-        // TODO: should we overwrite the key? e.g. char* identical strings in different memory locations?
-        dict->value_group[group_index].val[slot_index] = val;
-    } else {
-        // key was not found in the dict already, we get the group index it should go in, but we need to
-        // determine the next open slot from the slot mask
-        size_t slot_mask = slot_index;
-        int    bitpos    = ffs(~(uint16_t)slot_mask) - 1;
+static inline bool Dict_Set(Dict(Tkey_, Tval_) * dict, Tkey key, Tval val) {
+    return Dict_SetHashed(dict, key, Dict_Hash(dict, key), val);
+}
+
+/**
+ * @brief Upserts a key given its precomputed hash (from @ref Dict_Hash), see @ref Dict_Upsert
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_UpsertHashed(Dict(Tkey_, Tval_) * dict, Tkey key, uint64_t hash, bool* inserted) {
+    Dict_MigrateStep(dict);
+
+    size_t group_index, slot_index;
+    Tval*    val;
+    bool     found = Dict_Find(dict, key, hash, &group_index, &slot_index);
+
+    if (inserted != NULL) {
+        *inserted = false;
+    }
+
+    if (found) {
+        return &Dict_ValAt(dict, group_index, slot_index);
+    } else if ((val = Dict_FindOld(dict, key, hash)) != NULL) {
+        return val;
+    }
+
+    Dict_InsertSlot(dict, key, hash, group_index, slot_index);
+    val = &Dict_ValAt(dict, group_index, slot_index);
+    memset(val, 0, sizeof(Tval));
+
+    if (Dict_Load(dict) > Dict_MaxLoad(dict->capacity)) {
+        if (!Dict_CheckLoad(dict)) {
+            Dict_RemoveSlot(dict, group_index, slot_index);
+            return NULL;
+        }
+
+        // the entry was moved by the grow/rehash
+        val = Dict_FindValue(dict, key, hash);
+    }
+
+    if (inserted != NULL) {
+        *inserted = true;
+    }
+
+    return val;
+}
+
+/**
+ * @brief Gets a pointer to the value stored for a key, inserting the key with a zeroed value if it isn't present,
+ * in a single lookup
+ * @param dict The dictionary to look in/insert into
+ * @param key The key to look up
+ * @param inserted Where to record whether @param key was inserted, may be NULL
+ * @return A pointer to the key's value, or NULL if the key had to be inserted and growing the dict failed
+ * @warning The pointer is invalidated the same way as the one from @ref Dict_GetPtr
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_Upsert(Dict(Tkey_, Tval_) * dict, Tkey key, bool* inserted) {
+    return Dict_UpsertHashed(dict, key, Dict_Hash(dict, key), inserted);
+}
+
+/**
+ * @brief Looks up a batch of keys, hashing the whole batch and prefetching each key's first metadata group before
+ * resolving any of them so the cache misses overlap
+ * @param dict The dictionary to search
+ * @param keys The keys to look for
+ * @param count The number of keys in @param keys
+ * @param out_vals Where to write the value found for each key, entries for keys that weren't found are untouched
+ * @param found Where to record whether each key was found, may be NULL
+ * @return The number of keys that were found
+ */
+CTL_OVERLOADABLE
+static inline size_t Dict_GetMany(Dict(Tkey_, Tval_) * dict, Tkey* keys, size_t count, Tval* out_vals, bool* found) {
+    const size_t group_count = dict->capacity / 16;
+    size_t       found_count = 0;
+
+    for (size_t batch = 0; batch < count; batch += Dict_Batch_Size) {
+        size_t   batch_size = CTL_MIN(count - batch, (size_t)Dict_Batch_Size);
+        uint64_t hash[Dict_Batch_Size];
+
+        Dict_MigrateStep(dict);
+
+        for (size_t ii = 0; ii < batch_size; ii++) {
+            hash[ii]           = Dict_Hash(dict, keys[batch + ii]);
+            size_t group_index = Dict_GroupIndex(hash[ii], group_count);
+
+            __builtin_prefetch(&dict->metadata_group[group_index]);
+        }
+
+        for (size_t ii = 0; ii < batch_size; ii++) {
+            size_t group_index, slot_index;
+            bool   hit = Dict_Find(dict, keys[batch + ii], hash[ii], &group_index, &slot_index);
+            Tval*  old_val;
+
+            if (hit) {
+                out_vals[batch + ii] = Dict_ValAt(dict, group_index, slot_index);
+                found_count += 1;
+            } else if ((old_val = Dict_FindOld(dict, keys[batch + ii], hash[ii])) != NULL) {
+                hit                  = true;
+                out_vals[batch + ii] = *old_val;
+                found_count += 1;
+            }
+
+            if (found != NULL) {
+                found[batch + ii] = hit;
+            }
+        }
+    }
+
+    return found_count;
+}
+
+/**
+ * @brief Stores a batch of <key, value> pairs, hashing and prefetching ahead like @ref Dict_GetMany
+ * @param dict The dictionary to store to
+ * @param keys The keys to store
+ * @param vals The values to store, one per key
+ * @param count The number of pairs
+ * @return True if all pairs were stored, false if an allocation failed (pairs before the failure remain stored)
+ * @note Reserves space for all of the pairs up front so the table doesn't grow in the middle of a batch
+ * @note Only the metadata is prefetched, the key and value a probe lands on could be in any of the group's cache
+ * lines and prefetching the start of the group mostly wastes line fill buffers
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_SetMany(Dict(Tkey_, Tval_) * dict, Tkey* keys, Tval* vals, size_t count) {
+    if (!Dict_Reserve(dict, dict->size + count)) {
+        return false;
+    }
+
+    for (size_t batch = 0; batch < count; batch += Dict_Batch_Size) {
+        size_t   batch_size  = CTL_MIN(count - batch, (size_t)Dict_Batch_Size);
+        size_t   group_count = dict->capacity / 16;
+        uint64_t hash[Dict_Batch_Size];
+
+        for (size_t ii = 0; ii < batch_size; ii++) {
+            hash[ii]           = Dict_Hash(dict, keys[batch + ii]);
+            size_t group_index = Dict_GroupIndex(hash[ii], group_count);
+
+            __builtin_prefetch(&dict->metadata_group[group_index], 1);
+        }
+
+        for (size_t ii = 0; ii < batch_size; ii++) {
+            if (!Dict_SetHashed(dict, keys[batch + ii], hash[ii], vals[batch + ii])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Marks an occupied slot as unoccupied, avoiding a tombstone if no probe sequence can pass through the slot
+ */
+CTL_OVERLOADABLE
+static inline void Dict_RemoveSlot(Dict(Tkey_, Tval_) * dict, size_t group_index, size_t slot_index) {
+    dict->tombstones += Dict_VacateSlot(&dict->metadata_group[group_index], slot_index);
+
+#if Dict_Layout == Dict_Layout_Ordered
+    // the entry stays in the entry array as a hole until it's compacted, unless it's the last one
+    size_t entry_index = dict->index_group[group_index].index[slot_index];
+    dict->live[entry_index / 64] &= ~(1ull << (entry_index % 64));
+    if (entry_index + 1 == dict->entry_count) {
+        dict->entry_count -= 1;
+    }
+#endif
+
+    dict->size -= 1;
+}
+
+/**
+ * @brief Removes a key and its associated value from the dict
+ * @param dict The dictionary to remove from
+ * @param key The key to remove
+ * @return True if @param key was found and removed, false otherwise
+ * @note Removal leaves a tombstone unless the key's group has spare room, tombstones are reused by @ref Dict_Set and
+ * are cleaned up in place when they make up too much of the table
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Remove(Dict(Tkey_, Tval_) * dict, Tkey key) {
+    Dict_MigrateStep(dict);
+
+    uint64_t hash = Dict_Hash(dict, key);
+    size_t   group_index, slot_index;
+    if (Dict_Find(dict, key, hash, &group_index, &slot_index)) {
+        Dict_RemoveSlot(dict, group_index, slot_index);
+        return true;
+    }
+
+#if defined(Dict_Incremental)
+    if (dict->old_capacity != 0) {
+        Dict(Tkey_, Tval_) old = Dict_OldTable(dict);
+        if (Dict_Find(&old, key, hash, &group_index, &slot_index)) {
+            Dict_RemoveSlot(&old, group_index, slot_index);
+            dict->old_size = old.size;
+            dict->size -= 1;
+            return true;
+        }
+    }
+#endif
+
+    return false;
+}
+
+/**
+ * @brief Removes every <key, value> pair from the dict that @param predicate returns true for
+ * @param dict The dictionary to remove from
+ * @param predicate The function deciding whether a pair should be removed
+ * @param ctx An opaque pointer passed through to @param predicate
+ * @return The number of pairs removed
+ */
+CTL_OVERLOADABLE
+static inline size_t Dict_RemoveIf(
+    Dict(Tkey_, Tval_) * dict,
+    bool (*predicate)(Tkey* key, Tval* val, void* ctx),
+    void* ctx) {
+    Dict_FinishMigration(dict);
+
+    const size_t max_group_index = dict->capacity / 16;
+    size_t       removed         = 0;
+
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        uint16_t occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+            if (predicate(
+                    &Dict_KeyAt(dict, group_index, bitpos), &Dict_ValAt(dict, group_index, bitpos), ctx)) {
+                Dict_RemoveSlot(dict, group_index, bitpos);
+                removed += 1;
+            }
+        }
+    }
+
+    return removed;
+}
+
+/**
+ * @brief Clears the dict of all elements, resetting to a clean state
+ * @param dict The dict to clear
+ */
+CTL_OVERLOADABLE
+static inline void Dict_Clear(Dict(Tkey_, Tval_) * dict) {
+    Dict_Uninit(dict);
+    Dict_Init(dict, 0);
+}
+
+#if Dict_Layout == Dict_Layout_Ordered
+/**
+ * @brief Finds the first entry at or after @param entry_index that hasn't been removed, a word of the live entry
+ * bitmap at a time
+ * @return The index of the entry, or the dict's entry_count if there are none left
+ */
+CTL_OVERLOADABLE
+static inline size_t Dict_NextLive(Dict(Tkey_, Tval_) * dict, size_t entry_index) {
+    size_t word_count = (dict->entry_count + 63) / 64;
+    size_t word_index = entry_index / 64;
+
+    if (word_index >= word_count) {
+        return dict->entry_count;
+    }
+
+    uint64_t live_mask = dict->live[word_index] & (~0ull << (entry_index % 64));
+    while (live_mask == 0) {
+        word_index += 1;
+        if (word_index == word_count) {
+            return dict->entry_count;
+        }
+
+        live_mask = dict->live[word_index];
+    }
+
+    return word_index * 64 + __builtin_ctzll(live_mask);
+}
+#endif
+
+/**
+ * @brief Iteratively enumerate keys within the dict, returns a pointer to the next occupied key given an
+ * existing key in the dict
+ * @param dict The dictionary to enumerate
+ * @param prev_key The previous key, passing NULL will give provide the first key in the dict
+ * @return Returns NULL if @param prev_key was the last key in the dict, otherwise returns @param prev_key
+ * successor
+ * @note Every call recovers its position from @param prev_key, iterating the whole dict is cheaper with
+ * @ref Dict_ForEach or a @ref Dict_IterNext loop
+ */
+CTL_OVERLOADABLE
+static inline Tkey* Dict_EnumerateKeys(Dict(Tkey_, Tval_) * dict, Tkey* prev_key) {
+#if Dict_Layout == Dict_Layout_Ordered
+    // entries are enumerated in the order they were added, the previous one is found from its address
+    size_t entry_index = 0;
+    if (prev_key != NULL) {
+        entry_index = ((uintptr_t)prev_key - (uintptr_t)&dict->entry[0].key) / sizeof(dict->entry[0]) + 1;
+    }
+
+    entry_index = Dict_NextLive(dict, entry_index);
+    return entry_index < dict->entry_count ? &dict->entry[entry_index].key : NULL;
+#else
+    const size_t max_group_index = dict->capacity / 16;
+
+    if (prev_key == NULL) {
+        Dict_FinishMigration(dict);
+
+        if (dict->metadata_group[0].slot[0].occupied) {
+            // return the first one if no previous one was supplied and it's occupied
+            return &Dict_KeyAt(dict, 0, 0);
+        } else {
+            // set prevKey to the first one since we know it's empty
+            prev_key = &Dict_KeyAt(dict, 0, 0);
+        }
+    }
+
+    // find the group index and slot index
+    uintptr_t first_key_addr = (uintptr_t)&Dict_KeyAt(dict, 0, 0);
+    uintptr_t delta_bytes    = (uintptr_t)prev_key - first_key_addr;
+    size_t    group_index    = delta_bytes / Dict_KeyGroupStride;
+    size_t    slot_index     = (delta_bytes - group_index * Dict_KeyGroupStride) / Dict_KeySlotStride;
+
+    // check if there is another slot in this group that is occupied after prev key
+    uint16_t occupied_mask       = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+    uint16_t clear_mask          = (1ull << ((uint32_t)slot_index + 1)) - 1;
+    uint16_t upper_occupied_mask = occupied_mask & ~clear_mask;
+
+    if (upper_occupied_mask) {
+        int next_slot = ffs(upper_occupied_mask) - 1;
+        return &Dict_KeyAt(dict, group_index, next_slot);
+    }
+
+    // if none were set we need to increment the group index and check the next group
+    group_index += 1;
+
+    for (; group_index < max_group_index; group_index += 1) {
+        occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+
+        if (occupied_mask) {
+            int next_slot = ffs(occupied_mask) - 1;
+            return &Dict_KeyAt(dict, group_index, next_slot);
+        }
+    }
+
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Iteratively enumerate values within the dict, returns a pointer to the next occupied value given
+ * an existing value in the dict
+ * @param dict The dictionary to enumerate
+ * @param prev_value The previous value, passing NULL will give provide the first value in the dict
+ * @return Returns NULL if @param prev_value was the last value in the dict, otherwise returns @param prev_value
+ * successor
+ * @note Every call recovers its position from @param prev_value, iterating the whole dict is cheaper with
+ * @ref Dict_ForEach or a @ref Dict_IterNext loop
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_EnumerateValues(Dict(Tkey_, Tval_) * dict, Tval* prev_value) {
+#if Dict_Layout == Dict_Layout_Ordered
+    // entries are enumerated in the order they were added, the previous one is found from its address
+    size_t entry_index = 0;
+    if (prev_value != NULL) {
+        entry_index = ((uintptr_t)prev_value - (uintptr_t)&dict->entry[0].val) / sizeof(dict->entry[0]) + 1;
+    }
+
+    entry_index = Dict_NextLive(dict, entry_index);
+    return entry_index < dict->entry_count ? &dict->entry[entry_index].val : NULL;
+#else
+    const size_t max_group_index = dict->capacity / 16;
+
+    if (prev_value == NULL) {
+        Dict_FinishMigration(dict);
+
+        if (dict->metadata_group[0].slot[0].occupied) {
+            // return the first one if no previous one was supplied and it's occupied
+            return &Dict_ValAt(dict, 0, 0);
+        } else {
+            // set prevKey to the first one since we know it's empty
+            prev_value = &Dict_ValAt(dict, 0, 0);
+        }
+    }
+
+    // find the group index and slot index
+    uintptr_t first_key_addr = (uintptr_t)&Dict_ValAt(dict, 0, 0);
+    uintptr_t delta_bytes    = (uintptr_t)prev_value - first_key_addr;
+    size_t    group_index    = delta_bytes / Dict_ValGroupStride;
+    size_t    slot_index     = (delta_bytes - group_index * Dict_ValGroupStride) / Dict_ValSlotStride;
+
+    // check if there is another slot in this group that is occupied after prev key
+    uint16_t occupied_mask       = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+    uint16_t clear_mask          = (1ull << ((uint32_t)slot_index + 1)) - 1;
+    uint16_t upper_occupied_mask = occupied_mask & ~clear_mask;
+
+    if (upper_occupied_mask) {
+        int next_slot = ffs(upper_occupied_mask) - 1;
+        assert(group_index < max_group_index);
+        return &Dict_ValAt(dict, group_index, next_slot);
+    }
+
+    // if none were set we need to increment the group index and check the next group
+    group_index += 1;
+
+    for (; group_index < max_group_index; group_index += 1) {
+        occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+
+        if (occupied_mask) {
+            int next_slot = ffs(occupied_mask) - 1;
+            assert(group_index < max_group_index);
+            return &Dict_ValAt(dict, group_index, next_slot);
+        }
+    }
+
+    return NULL;
+#endif
+}
+
+typedef struct Dict_Iter(Tkey_, Tval_) {
+    Dict(Tkey_, Tval_) * dict;
+#if Dict_Layout == Dict_Layout_Ordered
+    size_t   word_index;
+    uint64_t live_mask; // live entries of word_index's word of the bitmap that haven't been visited yet
+#else
+    size_t   group_index;
+    uint16_t occupied_mask; // occupied slots of group_index that haven't been visited yet
+#endif
+    Tkey* key;
+    Tval* val;
+}
+Dict_Iter(Tkey_, Tval_);
+
+/**
+ * @brief Creates a cursor positioned before the first entry of the dict, advance it with @ref Dict_IterNext
+ * @param dict The dict to iterate over
+ * @return The cursor
+ */
+CTL_OVERLOADABLE
+static inline Dict_Iter(Tkey_, Tval_) Dict_IterStart(Dict(Tkey_, Tval_) * dict) {
+    Dict_FinishMigration(dict);
+
+    Dict_Iter(Tkey_, Tval_) iter = {
+        .dict = dict,
+#if Dict_Layout == Dict_Layout_Ordered
+        .word_index = 0,
+        .live_mask  = dict->live[0],
+#else
+        .group_index   = 0,
+        .occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[0]),
+#endif
+        .key = NULL,
+        .val = NULL,
+    };
+
+    return iter;
+}
+
+/**
+ * @brief Advances the cursor to the next entry, skipping whole groups without occupied slots (an ordered dict's
+ * cursor visits its entries in insertion order instead)
+ * @param iter The cursor to advance
+ * @return True if the cursor's key and val point at the next entry, false if there are no entries left
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_IterNext(Dict_Iter(Tkey_, Tval_) * iter) {
+#if Dict_Layout == Dict_Layout_Ordered
+    const size_t word_count = (iter->dict->entry_count + 63) / 64;
+
+    while (iter->live_mask == 0) {
+        if (iter->word_index + 1 >= word_count) {
+            iter->word_index = word_count;
+            return false;
+        }
+
+        iter->word_index += 1;
+        iter->live_mask = iter->dict->live[iter->word_index];
+    }
+
+    size_t entry_index = iter->word_index * 64 + __builtin_ctzll(iter->live_mask);
+    iter->live_mask &= iter->live_mask - 1;
+
+    iter->key = &iter->dict->entry[entry_index].key;
+    iter->val = &iter->dict->entry[entry_index].val;
+    return true;
+#else
+    const size_t max_group_index = iter->dict->capacity / 16;
+
+    while (iter->occupied_mask == 0) {
+        if (iter->group_index + 1 >= max_group_index) {
+            iter->group_index = max_group_index;
+            return false;
+        }
+
+        iter->group_index += 1;
+        iter->occupied_mask = Dict_OccupiedBitmask(iter->dict->metadata_group[iter->group_index]);
+    }
+
+    int slot_index = __builtin_ctz(iter->occupied_mask);
+    iter->occupied_mask &= iter->occupied_mask - 1;
+
+    iter->key = &Dict_KeyAt(iter->dict, iter->group_index, slot_index);
+    iter->val = &Dict_ValAt(iter->dict, iter->group_index, slot_index);
+    return true;
+#endif
+}
+
+#if Dict_Layout == Dict_Layout_Ordered
+/**
+ * @brief Copies the dict's live entries in order to the front of @param dst's entry array and rebuilds @param dst's
+ * index for them, dropping the holes removed entries left behind
+ * @param dst Either the dict itself, to compact it in place, or a new table with the same seed
+ * @note Doesn't adjust @param dst's size, the entries are being moved rather than added
+ */
+CTL_OVERLOADABLE
+static inline void Dict_Compact(Dict(Tkey_, Tval_) * dict, Dict(Tkey_, Tval_) * dst) {
+    const size_t group_count = dst->capacity / 16;
+    size_t       entry_count = 0;
+
+    // entries only ever move towards the front, so compacting in place never overwrites one that hasn't moved yet
+    for (size_t entry_index = Dict_NextLive(dict, 0); entry_index < dict->entry_count;
+         entry_index        = Dict_NextLive(dict, entry_index + 1)) {
+        dst->entry[entry_count++] = dict->entry[entry_index];
+    }
+
+    memset(dst->metadata_group, 0, group_count * sizeof(Dict_MetadataGroup));
+    memset(dst->live, 0, Dict_LiveWords(dst->capacity) * sizeof(uint64_t));
+    dst->entry_count = entry_count;
+    dst->tombstones  = 0;
+
+    for (size_t entry_index = 0; entry_index < entry_count; entry_index++) {
+#    if defined(Dict_CacheHash)
+        uint64_t hash = dst->entry[entry_index].hash;
+#    else
+        uint64_t hash = Dict_Hash(dst, dst->entry[entry_index].key);
+#    endif
+
+        // the index is rebuilt from scratch, so the first group on the probe sequence that isn't full gets the entry
+        Dict_Probe probe = Dict_ProbeStart(dst, hash, group_count);
+        uint16_t   occupied_mask;
+        while ((occupied_mask = Dict_OccupiedBitmask(dst->metadata_group[probe.index])) == 0xFFFF) {
+            Dict_ProbeNext(dst, &probe);
+        }
+
+        int slot_index = ffs(~occupied_mask) - 1;
+
+        dst->metadata_group[probe.index].slot[slot_index] = Dict_OccupiedMetadata(hash);
+        dst->index_group[probe.index].index[slot_index]   = (uint32_t)entry_index;
+        dst->live[entry_index / 64] |= 1ull << (entry_index % 64);
+    }
+}
+#endif
+
+/**
+ * @brief Rehashes the dict without resizing it, clearing out all tombstones
+ * @param dict The dict to rehash
+ * @note This doesn't allocate, entries are moved around within the existing table
+ */
+CTL_OVERLOADABLE
+static inline void Dict_Rehash(Dict(Tkey_, Tval_) * dict) {
+#if Dict_Layout == Dict_Layout_Ordered
+    // the holes removed entries left in the entry array are cleaned up along with the tombstones
+    Dict_Compact(dict, dict);
+#else
+    const size_t max_group_index = dict->capacity / 16;
+
+    // afterwards every slot that needs to be (re)placed is marked deleted, and every free slot is empty
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        Dict_PrepareRehash(&dict->metadata_group[group_index]);
+    }
+
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        for (int slot_index = 0; slot_index < 16; slot_index++) {
+            if (dict->metadata_group[group_index].slot[slot_index].u8 != Dict_Metadata_Deleted) {
+                continue;
+            }
+
+            Tkey*    key  = &Dict_KeyAt(dict, group_index, slot_index);
+            Tval*    val  = &Dict_ValAt(dict, group_index, slot_index);
+            uint64_t hash = Dict_SlotHash(dict, group_index, slot_index);
+
+            // find the first group on the probe sequence that isn't full, we can stop at the current group since
+            // the slot we're in is free for this entry
+            Dict_Probe probe = Dict_ProbeStart(dict, hash, max_group_index);
+            uint16_t   occupied_mask;
+            while ((occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[probe.index])) == 0xFFFF &&
+                   probe.index != group_index) {
+                Dict_ProbeNext(dict, &probe);
+            }
+
+            size_t target_group = probe.index;
+
+            Dict_Metadata metadata = Dict_OccupiedMetadata(hash);
+
+            if (target_group == group_index) {
+                // already in the right group
+                dict->metadata_group[group_index].slot[slot_index] = metadata;
+                continue;
+            }
+
+            int   target_slot = ffs(~occupied_mask) - 1;
+            Tkey* target_key  = &Dict_KeyAt(dict, target_group, target_slot);
+            Tval* target_val  = &Dict_ValAt(dict, target_group, target_slot);
+            bool  swap        = dict->metadata_group[target_group].slot[target_slot].u8 == Dict_Metadata_Deleted;
+
+            if (swap) {
+                // the target holds another entry that still needs placing, swap it in here and process it next
+                Tkey tmp_key = *target_key;
+                Tval tmp_val = *target_val;
+                *target_key  = *key;
+                *target_val  = *val;
+                *key         = tmp_key;
+                *val         = tmp_val;
+#if defined(Dict_CacheHash)
+                Dict_HashAt(dict, group_index, slot_index) = Dict_HashAt(dict, target_group, target_slot);
+#endif
+            } else {
+                *target_key = *key;
+                *target_val = *val;
+
+                dict->metadata_group[group_index].slot[slot_index].u8 = Dict_Metadata_Empty;
+            }
+
+            dict->metadata_group[target_group].slot[target_slot] = metadata;
+#if defined(Dict_CacheHash)
+            Dict_HashAt(dict, target_group, target_slot) = hash;
+#endif
+
+            if (swap) {
+                slot_index -= 1;
+            }
+        }
+    }
+
+    dict->tombstones = 0;
+#endif
+}
+
+#if defined(Dict_GrowInPlace)
+/**
+ * @brief Grows the dict to @param capacity slots by reallocating its block and redistributing the entries inside it
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_ReallocTo(Dict(Tkey_, Tval_) * dict, size_t capacity) {
+    size_t old_metadata_group_size = dict->capacity / 16 * sizeof(Dict_MetadataGroup);
+    size_t old_entry_size          = dict->capacity / 16 * Dict_GroupSize;
+    size_t metadata_group_size     = capacity / 16 * sizeof(Dict_MetadataGroup);
+
+    void* block = Dict_Realloc(dict->metadata_group, Dict_TableSize(dict, capacity));
+    if (block == NULL) {
+        return false;
+    }
+
+    // every array only moves up in the bigger block, so move them back to front to not overwrite one that hasn't
+    // been moved yet
+#    if defined(Dict_CacheHash)
+    memmove(
+        block + metadata_group_size + capacity / 16 * Dict_GroupSize,
+        block + old_metadata_group_size + old_entry_size,
+        dict->capacity * sizeof(uint64_t));
+#    endif
+#    if Dict_Layout == Dict_Layout_Interleaved
+    memmove(block + metadata_group_size, block + old_metadata_group_size, old_entry_size);
+#    else
+    size_t old_key_group_size = dict->capacity / 16 * sizeof(Dict_KeyGroup(Tkey_, Tval_));
+    size_t key_group_size     = capacity / 16 * sizeof(Dict_KeyGroup(Tkey_, Tval_));
+    memmove(
+        block + metadata_group_size + key_group_size,
+        block + old_metadata_group_size + old_key_group_size,
+        old_entry_size - old_key_group_size);
+    memmove(block + metadata_group_size, block + old_metadata_group_size, old_key_group_size);
+#    endif
+    memset(block + old_metadata_group_size, 0, metadata_group_size - old_metadata_group_size);
+
+    dict->capacity = capacity;
+    Dict_SetTable(dict, block);
+
+    // the entries are all in the lower half of the table now, put them where they belong for the new capacity
+    Dict_Rehash(dict);
+
+    return true;
+}
+#endif
+
+/**
+ * @brief Moves the dict's contents into a new table with @param capacity slots
+ * @param dict The dict to grow
+ * @param capacity The new capacity, of the form 2^N * 16
+ * @return True if the dict was grown, false if the allocation failed (the dict is left untouched)
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_GrowTo(Dict(Tkey_, Tval_) * dict, size_t capacity) {
+    Dict_FinishMigration(dict);
+
+#if defined(Dict_GrowInPlace)
+    if (!Dict_IsInline(dict)) {
+        return Dict_ReallocTo(dict, capacity);
+    }
+#endif
+
+    // create a new temp dict to use as a temporary
+    Dict(Tkey_, Tval_) dict_new;
+    if (!Dict_InitWithSeed(&dict_new, capacity - 1, dict->seed)) {
+        return false;
+    }
+
+#if Dict_Layout == Dict_Layout_Ordered
+    // the entries are copied over in order and only the index is built for the new capacity
+    Dict_Compact(dict, &dict_new);
+#else
+    const size_t max_group_index = dict->capacity / 16;
+
+    // move every occupied slot straight into the first free slot on its probe sequence in the new table, keys are
+    // already known to be unique so there's nothing to compare and the new table can't need to grow
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        uint16_t occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+            Dict_PlaceEntry(
+                &dict_new,
+                Dict_KeyAt(dict, group_index, bitpos),
+                Dict_SlotHash(dict, group_index, bitpos),
+                Dict_ValAt(dict, group_index, bitpos));
+        }
+    }
+#endif
+
+    dict_new.size = dict->size;
+#if defined(Dict_Stats)
+    dict_new.stats = dict->stats;
+#endif
+
+    // free the old dict, copy the new one's pointers
+    Dict_Uninit(dict);
+    Dict_Assign(dict, &dict_new);
+
+    return true;
+}
+
+CTL_OVERLOADABLE
+static inline bool Dict_Grow(Dict(Tkey_, Tval_) * dict) {
+#if defined(Dict_Incremental)
+    if (Dict_IsInline(dict)) {
+        // the inline group is part of the struct that's about to be overwritten, it's small enough to just copy
+        return Dict_GrowTo(dict, 2 * dict->capacity);
+    }
+
+    // only allocate the new table here, the entries are moved over a few groups at a time by later operations
+    Dict(Tkey_, Tval_) dict_new;
+    if (!Dict_InitWithSeed(&dict_new, 2 * dict->capacity - 1, dict->seed)) {
+        return false;
+    }
+
+    dict_new.size               = dict->size;
+    dict_new.old_capacity       = dict->capacity;
+    dict_new.old_size           = dict->size;
+    dict_new.migrate_index      = 0;
+    dict_new.old_metadata_group = dict->metadata_group;
+#    if Dict_Layout == Dict_Layout_Interleaved
+    dict_new.old_entry_group = dict->entry_group;
+#    else
+    dict_new.old_key_group   = dict->key_group;
+    dict_new.old_value_group = dict->value_group;
+#    endif
+#    if defined(Dict_CacheHash)
+    dict_new.old_hash = dict->hash;
+#    endif
+#    if defined(Dict_Stats)
+    dict_new.stats = dict->stats;
+#    endif
+
+    Dict_Assign(dict, &dict_new);
+    return true;
+#else
+    return Dict_GrowTo(dict, 2 * dict->capacity);
+#endif
+}
+
+/**
+ * @brief Grows the dict so that it can hold @param count entries without growing again, if the dict can already
+ * hold @param count entries do nothing
+ * @param dict The dict to reserve space in
+ * @param count The number of entries to reserve space for
+ * @return True if the dict was able to reserve enough space, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Reserve(Dict(Tkey_, Tval_) * dict, size_t count) {
+    size_t capacity = dict->capacity;
+    while (count > Dict_MaxLoad(capacity)) {
+        capacity *= 2;
+    }
+
+    if (capacity == dict->capacity) {
+        return true;
+    }
+
+#if defined(Dict_Stats)
+    uint64_t start = __rdtsc();
+#endif
+    bool grown = Dict_GrowTo(dict, capacity);
+    Dict_StatsAdd(dict, grows, grown);
+    Dict_StatsAdd(dict, grow_cycles, __rdtsc() - start);
+
+    return grown;
+}
+
+#if defined(Dict_Stats)
+/**
+ * @brief Zeroes the dict's stats counters, e.g. to only count a workload's steady state
+ */
+CTL_OVERLOADABLE
+static inline void Dict_ResetStats(Dict(Tkey_, Tval_) * dict) {
+    memset(&dict->stats, 0, sizeof(dict->stats));
+}
+
+/**
+ * @brief Prints the dict's stats counters, probe length histograms and how many groups hold each number of
+ * entries to @param out
+ * @note Long probes on hits and a high tag false positive rate at a low load point at Dict_HashKey, long probes
+ * with a reasonable false positive rate at clustering (Dict_Probing) or too high a Dict_MaxLoad
+ */
+CTL_OVERLOADABLE
+static inline void Dict_PrintStats(Dict(Tkey_, Tval_) * dict, FILE* out) {
+    Dict_Counters* stats           = &dict->stats;
+    uint64_t       false_positives = stats->tag_matches - stats->hits;
+
+    fprintf(
+        out,
+        "size %zu, capacity %zu, tombstones %zu, load %.3f\n",
+        dict->size,
+        dict->capacity,
+        dict->tombstones,
+        (double)(dict->size + dict->tombstones) / (double)dict->capacity);
+    fprintf(
+        out,
+        "hits %llu (%.3f groups each), misses %llu (%.3f groups each)\n",
+        (unsigned long long)stats->hits,
+        stats->hits ? (double)stats->hit_groups / (double)stats->hits : 0.0,
+        (unsigned long long)stats->misses,
+        stats->misses ? (double)stats->miss_groups / (double)stats->misses : 0.0);
+    fprintf(
+        out,
+        "tag matches %llu, false positives %llu (%.1f%%), key compares %llu\n",
+        (unsigned long long)stats->tag_matches,
+        (unsigned long long)false_positives,
+        stats->tag_matches ? 100.0 * (double)false_positives / (double)stats->tag_matches : 0.0,
+        (unsigned long long)stats->compares);
+    fprintf(
+        out,
+        "grows %llu, rehashes %llu, %llu cycles\n",
+        (unsigned long long)stats->grows,
+        (unsigned long long)stats->rehashes,
+        (unsigned long long)stats->grow_cycles);
+
+    fprintf(out, "groups probed  hits        misses\n");
+    for (size_t ii = 0; ii < Dict_Stats_Buckets; ii++) {
+        fprintf(
+            out,
+            "%2zu%-12s %-11llu %llu\n",
+            ii + 1,
+            ii + 1 == Dict_Stats_Buckets ? "+" : "",
+            (unsigned long long)stats->hit_histogram[ii],
+            (unsigned long long)stats->miss_histogram[ii]);
+    }
+
+    size_t occupancy[17] = {0};
+    for (size_t group_index = 0; group_index < dict->capacity / 16; group_index++) {
+        occupancy[__builtin_popcount(Dict_OccupiedBitmask(dict->metadata_group[group_index]))] += 1;
+    }
+
+    fprintf(out, "entries in group  groups\n");
+    for (size_t ii = 0; ii <= 16; ii++) {
+        fprintf(out, "%2zu                %zu\n", ii, occupancy[ii]);
+    }
+}
+#endif
+
+#if defined(Dict_Mappable)
+/**
+ * @brief Gets the header Dict_Save writes for the dict
+ */
+CTL_OVERLOADABLE
+static inline Dict_FileHeader Dict_FileHeaderOf(Dict(Tkey_, Tval_) * dict) {
+    Dict_FileHeader header = {
+        .magic   = Dict_File_Magic,
+        .version = Dict_File_Version,
+        .layout  = Dict_Layout,
+        .probing = Dict_Probing,
+#    if defined(Dict_CacheHash)
+        .cache_hash = 1,
+#    endif
+        .key_size   = sizeof(Tkey),
+        .value_size = sizeof(Tval),
+        .capacity   = dict->capacity,
+        .size       = dict->size,
+        .tombstones = dict->tombstones,
+        .seed       = dict->seed,
+    };
+
+    return header;
+}
+
+/**
+ * @brief Writes the dict's table to a file that @ref Dict_MapFile can open
+ * @param dict The dict to save
+ * @param path The path of the file to write, replaced if it exists
+ * @return True if the whole file was written, false otherwise
+ * @warning Keys and values are written as they are in memory, types holding pointers (e.g. char* keys) can't be
+ * saved meaningfully
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Save(Dict(Tkey_, Tval_) * dict, const char* path) {
+    Dict_FinishMigration(dict);
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    // written an array at a time since the table could be the dict's inline group rather than one block
+    Dict_FileHeader header      = Dict_FileHeaderOf(dict);
+    size_t          group_count = dict->capacity / 16;
+    bool            written     = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    written = written && fwrite(dict->metadata_group, sizeof(Dict_MetadataGroup), group_count, file) == group_count;
+#    if Dict_Layout == Dict_Layout_Interleaved
+    written = written &&
+              fwrite(dict->entry_group, sizeof(Dict_EntryGroup(Tkey_, Tval_)), group_count, file) == group_count;
+#    else
+    written =
+        written && fwrite(dict->key_group, sizeof(Dict_KeyGroup(Tkey_, Tval_)), group_count, file) == group_count;
+    written = written &&
+              fwrite(dict->value_group, sizeof(Dict_ValueGroup(Tkey_, Tval_)), group_count, file) == group_count;
+#    endif
+#    if defined(Dict_CacheHash)
+    written = written && fwrite(dict->hash, sizeof(uint64_t), dict->capacity, file) == dict->capacity;
+#    endif
+
+    return fclose(file) == 0 && written;
+}
+
+/**
+ * @brief Opens a file written by @ref Dict_Save as a dict by mapping it read-only, nothing is read or rehashed up
+ * front so opening costs about the same at any size and pages are faulted in as lookups touch them
+ * @param dict The dict to open the file as, must not be initialized
+ * @param path The path of the file to open
+ * @return True if the file was mapped, false if it couldn't be or was written by a different instantiation
+ * @warning The dict is read-only, anything that adds or removes entries faults, @ref Dict_Copy it for a writable
+ * dict. @ref Dict_Uninit unmaps the file
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_MapFile(Dict(Tkey_, Tval_) * dict, const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    void*       mapping = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(Dict_FileHeader)) {
+        mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    Dict_FileHeader* header = mapping;
+
+    memset(dict, 0, sizeof(*dict));
+    dict->capacity     = header->capacity;
+    dict->size         = header->size;
+    dict->tombstones   = header->tombstones;
+    dict->seed         = header->seed;
+    dict->mapping      = mapping;
+    dict->mapping_size = info.st_size;
+
+    Dict_FileHeader expected = Dict_FileHeaderOf(dict);
+    if (memcmp(header, &expected, sizeof(expected)) != 0 || dict->capacity < 16 ||
+        (dict->capacity & (dict->capacity - 1)) != 0 ||
+        (size_t)info.st_size != sizeof(Dict_FileHeader) + Dict_TableSize(dict, dict->capacity)) {
+        munmap(mapping, info.st_size);
+        dict->mapping = NULL;
+        return false;
+    }
+
+    Dict_SetTable(dict, (uint8_t*)mapping + sizeof(Dict_FileHeader));
+    return true;
+}
+#endif
+
+CTL_OVERLOADABLE
+static inline bool Dict_Copy(Dict(Tkey_, Tval_) * src_dict, Dict(Tkey_, Tval_) * dst_dict) {
+    Dict_FinishMigration(src_dict);
+
+    // new_dict will be manipulated to prevent breaking dst_dict in the event of an allocation failure
+    Dict(Tkey_, Tval_) new_dict;
+    // the entries are copied where they are, so the copy has to hash keys with the same seed
+    if (!Dict_InitWithSeed(&new_dict, src_dict->capacity - 1, src_dict->seed)) {
+        return false;
+    }
+
+    // copy the source dict's data to the new dict's data, an array at a time since either dict's table could be its
+    // inline group rather than one contiguous block
+    size_t group_count = src_dict->capacity / 16;
+    memcpy(new_dict.metadata_group, src_dict->metadata_group, group_count * sizeof(Dict_MetadataGroup));
+#if Dict_Layout == Dict_Layout_Interleaved
+    memcpy(new_dict.entry_group, src_dict->entry_group, group_count * sizeof(Dict_EntryGroup(Tkey_, Tval_)));
+#elif Dict_Layout == Dict_Layout_Ordered
+    memcpy(new_dict.index_group, src_dict->index_group, group_count * sizeof(Dict_IndexGroup));
+    memcpy(new_dict.live, src_dict->live, Dict_LiveWords(src_dict->capacity) * sizeof(uint64_t));
+    memcpy(new_dict.entry, src_dict->entry, src_dict->entry_count * sizeof(Dict_Entry(Tkey_, Tval_)));
+    new_dict.entry_count = src_dict->entry_count;
+#else
+    memcpy(new_dict.key_group, src_dict->key_group, group_count * sizeof(Dict_KeyGroup(Tkey_, Tval_)));
+    memcpy(new_dict.value_group, src_dict->value_group, group_count * sizeof(Dict_ValueGroup(Tkey_, Tval_)));
+#endif
+#if defined(Dict_CacheHash) && Dict_Layout != Dict_Layout_Ordered
+    memcpy(new_dict.hash, src_dict->hash, src_dict->capacity * sizeof(uint64_t));
+#endif
+    new_dict.size       = src_dict->size;
+    new_dict.tombstones = src_dict->tombstones;
+
+    // free the dst_dict, then copy new_dict to it so that it's now the duplicate
+    Dict_Uninit(dst_dict);
+    Dict_Assign(dst_dict, &new_dict);
+
+    return true;
+}
+
+/**
+ * @brief Merges one of @param src_dict's <key, value> pairs into @param dst_dict, see @ref Dict_Merge
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_MergeEntry(
+    Dict(Tkey_, Tval_) * dst_dict,
+    Tkey     key,
+    uint64_t hash,
+    Tval*    src_val,
+    void (*combine)(Tval* dst_val, Tval* src_val, void* ctx),
+    void* ctx) {
+    bool  inserted;
+    Tval* dst_val = Dict_UpsertHashed(dst_dict, key, hash, &inserted);
+    if (dst_val == NULL) {
+        return false;
+    }
+
+    if (inserted || combine == NULL) {
+        *dst_val = *src_val;
+    } else {
+        combine(dst_val, src_val, ctx);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Merges every <key, value> pair of @param src_dict into @param dst_dict, e.g. to combine partial
+ * aggregations built by several threads
+ * @param dst_dict The dict to merge into
+ * @param src_dict The dict to merge from, left unchanged
+ * @param combine Called for keys in both dicts to fold src_dict's value into dst_dict's, NULL overwrites dst_dict's
+ * value with src_dict's
+ * @param ctx An opaque pointer passed through to @param combine
+ * @return True if every pair was merged, false if @param dst_dict had to grow and couldn't (it then holds some of
+ * src_dict's pairs)
+ * @note Every key of src_dict is hashed for dst_dict, except with Dict_CacheHash when the dicts have the same seed
+ * (e.g. the dicts of a Dict_Partitioned, or Dict_InitWithSeed) or a custom Dict_HashKey that ignores seeds, then
+ * src_dict's cached hashes are reused and nothing is hashed at all
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Merge(
+    Dict(Tkey_, Tval_) * dst_dict,
+    Dict(Tkey_, Tval_) * src_dict,
+    void (*combine)(Tval* dst_val, Tval* src_val, void* ctx),
+    void* ctx) {
+    Dict_FinishMigration(src_dict);
+
+#if defined(Dict_CacheHash)
+    // two dicts hash a key the same way if they share a seed, or if the instantiation's hash doesn't use one
+    bool same_seed = !Dict_HashUsesSeed || dst_dict->seed == src_dict->seed;
+#endif
+
+#if Dict_Layout == Dict_Layout_Ordered
+    // in src_dict's order, the entries are appended to dst_dict's
+    for (size_t entry_index = Dict_NextLive(src_dict, 0); entry_index < src_dict->entry_count;
+         entry_index        = Dict_NextLive(src_dict, entry_index + 1)) {
+        Dict_Entry(Tkey_, Tval_)* entry = &src_dict->entry[entry_index];
+#    if defined(Dict_CacheHash)
+        uint64_t hash = same_seed ? entry->hash : Dict_Hash(dst_dict, entry->key);
+#    else
+        uint64_t hash = Dict_Hash(dst_dict, entry->key);
+#    endif
+
+        if (!Dict_MergeEntry(dst_dict, entry->key, hash, &entry->val, combine, ctx)) {
+            return false;
+        }
+    }
+#else
+    for (size_t group_index = 0; group_index < src_dict->capacity / 16; group_index++) {
+        uint16_t occupied_mask = Dict_OccupiedBitmask(src_dict->metadata_group[group_index]);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos   = ffs(imask) - 1;
+            Tkey key = Dict_KeyAt(src_dict, group_index, bitpos);
+#    if defined(Dict_CacheHash)
+            uint64_t hash = same_seed ? Dict_SlotHash(src_dict, group_index, bitpos) : Dict_Hash(dst_dict, key);
+#    else
+            uint64_t hash = Dict_Hash(dst_dict, key);
+#    endif
+
+            if (!Dict_MergeEntry(dst_dict, key, hash, &Dict_ValAt(src_dict, group_index, bitpos), combine, ctx)) {
+                return false;
+            }
+        }
+    }
+#endif
+
+    return true;
+}
+
+/* --- Frozen dicts --- */
+
+// an immutable, minimally perfectly hashed copy of a dict's entries, see Dict_Freeze
+typedef struct Dict_Frozen(Tkey_, Tval_) {
+    size_t    size;
+    size_t    bucket_count;
+    uint64_t  seed;
+    uint32_t* displacement;
+    Tkey*     key;
+    Tval*     val;
+}
+Dict_Frozen(Tkey_, Tval_);
+
+/**
+ * @brief Computes the hash the frozen dict uses for @param key, the same hash the dict it was frozen from used
+ */
+CTL_OVERLOADABLE
+static inline uint64_t Dict_Hash(Dict_Frozen(Tkey_, Tval_) * frozen, Tkey key) {
+    if (sizeof(Dict_HashKeySeeded(key, frozen->seed)) >= sizeof(uint64_t)) {
+        return Dict_MixHash(Dict_HashKeySeeded(key, frozen->seed));
+    } else {
+        return Dict_WidenHash(Dict_HashKeySeeded(key, frozen->seed));
+    }
+}
+
+/**
+ * @brief Gets the slot of the frozen dict the key with @param hash is stored in, if it's stored at all
+ */
+CTL_OVERLOADABLE
+static inline size_t Dict_FrozenSlot(Dict_Frozen(Tkey_, Tval_) * frozen, uint64_t hash) {
+    uint32_t displacement = frozen->displacement[Dict_FastRange(hash, frozen->bucket_count)];
+    return Dict_FastRange(Dict_Mix64(hash ^ displacement), frozen->size);
+}
+
+/**
+ * @brief Frees a frozen dict's arrays
+ */
+CTL_OVERLOADABLE
+static inline void Dict_Uninit(Dict_Frozen(Tkey_, Tval_) * frozen) {
+    Dict_Free(frozen->displacement);
+    Dict_Free(frozen->key);
+    Dict_Free(frozen->val);
+
+    frozen->displacement = NULL;
+    frozen->key          = NULL;
+    frozen->val          = NULL;
+}
+
+/**
+ * @brief Builds an immutable copy of the dict's entries, packed densely into arrays of exactly dict->size keys and
+ * values and indexed by a minimal perfect hash (hash and displace, as in CHD), for dicts that are built once and
+ * then only looked up
+ * @param dict The dict to freeze, left unchanged
+ * @param frozen The frozen dict to initialize
+ * @return True if the frozen dict was built, false if an allocation failed or two keys have the same 64-bit hash
+ * (only possible with a custom Dict_HashKey)
+ * @note Every key hashes to a bucket and every bucket gets a displacement that sends its keys to free slots, the
+ * buckets with the most keys go first while there are still plenty of free slots. A lookup is then one hash, one
+ * displacement load and one key compare
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Freeze(Dict(Tkey_, Tval_) * dict, Dict_Frozen(Tkey_, Tval_) * frozen) {
+    Dict_FinishMigration(dict);
+
+    size_t size         = dict->size;
+    size_t bucket_count = size / Dict_Frozen_BucketLoad + 1;
+
+    frozen->size         = size;
+    frozen->bucket_count = bucket_count;
+    frozen->seed         = dict->seed;
+    frozen->displacement = Dict_Malloc(bucket_count * sizeof(uint32_t));
+    frozen->key          = Dict_Malloc(size * sizeof(Tkey) + 1);
+    frozen->val          = Dict_Malloc(size * sizeof(Tval) + 1);
+
+    // scratch: every entry's hash and table slot grouped by bucket, where each bucket starts, and which frozen
+    // slots are taken
+    uint64_t* hash       = Dict_Malloc(size * sizeof(uint64_t) + 1);
+    size_t*   entry      = Dict_Malloc(size * sizeof(size_t) + 1);
+    size_t*   bucket_end = Dict_Malloc((bucket_count + 1) * sizeof(size_t));
+    uint64_t* taken      = Dict_Malloc((size / 64 + 1) * sizeof(uint64_t));
+    size_t    slot[64];
+
+    bool built = frozen->displacement != NULL && frozen->key != NULL && frozen->val != NULL && hash != NULL &&
+                 entry != NULL && bucket_end != NULL && taken != NULL;
+
+    // counting sort the entries by bucket, bucket_end[b] ends up as the end of bucket b
+    size_t max_bucket_size = 0;
+    for (size_t pass = 0; built && pass < 2; pass++) {
+        for (size_t group_index = 0; group_index < dict->capacity / 16; group_index++) {
+            uint16_t occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+
+            for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+                bitpos              = ffs(imask) - 1;
+                uint64_t entry_hash = Dict_SlotHash(dict, group_index, bitpos);
+                size_t   bucket     = Dict_FastRange(entry_hash, bucket_count);
+
+                if (pass == 0) {
+                    bucket_end[bucket + 1] += 1;
+                } else {
+                    size_t index = bucket_end[bucket]++;
+                    hash[index]  = entry_hash;
+                    entry[index] = group_index * 16 + bitpos;
+                }
+            }
+        }
+
+        if (pass == 0) {
+            // bucket_end[b] is where bucket b starts for the second pass, it's advanced to where it ends
+            for (size_t bucket = 0; bucket < bucket_count; bucket++) {
+                max_bucket_size = CTL_MAX(max_bucket_size, bucket_end[bucket + 1]);
+                bucket_end[bucket + 1] += bucket_end[bucket];
+            }
+        }
+    }
+
+    // a bucket this big means the hash is badly broken, it couldn't be placed anyway
+    built = built && max_bucket_size <= 64;
+
+    for (size_t bucket_size = max_bucket_size; built && bucket_size > 0; bucket_size--) {
+        for (size_t bucket = 0; built && bucket < bucket_count; bucket++) {
+            size_t start = bucket == 0 ? 0 : bucket_end[bucket - 1];
+            if (bucket_end[bucket] - start != bucket_size) {
+                continue;
+            }
+
+            // keys with the same hash land on the same slot under every displacement
+            for (size_t ii = start; ii < bucket_end[bucket]; ii++) {
+                for (size_t jj = start; jj < ii; jj++) {
+                    built = built && hash[ii] != hash[jj];
+                }
+            }
+
+            bool placed = false;
+            for (uint64_t displacement = 0; built && !placed; displacement++) {
+                if (displacement > UINT32_MAX) {
+                    built = false;
+                    break;
+                }
+
+                placed = true;
+                for (size_t ii = 0; placed && ii < bucket_size; ii++) {
+                    slot[ii] = Dict_FastRange(Dict_Mix64(hash[start + ii] ^ displacement), size);
+                    placed   = !(taken[slot[ii] / 64] & (1ull << (slot[ii] % 64)));
+
+                    for (size_t jj = 0; placed && jj < ii; jj++) {
+                        placed = slot[jj] != slot[ii];
+                    }
+                }
+
+                if (placed) {
+                    frozen->displacement[bucket] = (uint32_t)displacement;
+                }
+            }
+
+            for (size_t ii = 0; built && ii < bucket_size; ii++) {
+                size_t group_index = entry[start + ii] / 16;
+                size_t slot_index  = entry[start + ii] % 16;
+
+                taken[slot[ii] / 64] |= 1ull << (slot[ii] % 64);
+                frozen->key[slot[ii]] = Dict_KeyAt(dict, group_index, slot_index);
+                frozen->val[slot[ii]] = Dict_ValAt(dict, group_index, slot_index);
+            }
+        }
+    }
+
+    Dict_Free(hash);
+    Dict_Free(entry);
+    Dict_Free(bucket_end);
+    Dict_Free(taken);
+
+    if (!built) {
+        Dict_Uninit(frozen);
+    }
+
+    return built;
+}
+
+/**
+ * @brief Looks up a pointer to the value stored for a key in a frozen dict
+ * @param frozen The frozen dict to search for the key
+ * @param key The key to look for
+ * @return A pointer to the value stored for @param key, or NULL if @param key isn't in the frozen dict
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_GetPtr(Dict_Frozen(Tkey_, Tval_) * frozen, Tkey key) {
+    if (frozen->size == 0) {
+        return NULL;
+    }
+
+    size_t slot = Dict_FrozenSlot(frozen, Dict_Hash(frozen, key));
+    return Dict_CompareKey(key, frozen->key[slot]) ? &frozen->val[slot] : NULL;
+}
+
+/**
+ * @brief Looks up a value given a key in a frozen dict, returns true if the key was found, false otherwise
+ * @param frozen The frozen dict to search for the key
+ * @param key The key to look for
+ * @param out_val A pointer to where to write the value found at @param key, if found
+ * @return True if @param key was found and the value was written to @param out_val, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Get(Dict_Frozen(Tkey_, Tval_) * frozen, Tkey key, Tval* out_val) {
+    Tval* val = Dict_GetPtr(frozen, key);
+    if (val != NULL) {
+        *out_val = *val;
+        return true;
+    }
+
+    return false;
+}
+
+/* --- Sharded dicts --- */
+
+// one shard of a sharded dict, aligned so that every shard's lock and dict start their own cache line
+typedef struct Dict_Shard(Tkey_, Tval_) {
+    uint32_t lock;
+    Dict(Tkey_, Tval_) dict;
+} __attribute__((aligned(64))) Dict_Shard(Tkey_, Tval_);
 
-        dict->value_group[group_index].val[bitpos] = val;
-        dict->key_group[group_index].key[bitpos]   = key;
+// a dict partitioned into independently locked shards for use from multiple threads, see Dict_InitSharded
+typedef struct Dict_Sharded(Tkey_, Tval_) {
+    size_t shard_count;
+    Dict_Shard(Tkey_, Tval_) * shard;
+    void* block; // the allocation shard was aligned within
+}
+Dict_Sharded(Tkey_, Tval_);
+
+/**
+ * @brief Initializes a sharded dict, a dict split into @param shard_count dicts that each have their own lock, so
+ * threads working on different shards don't contend and a growing shard only blocks the threads that need it
+ * @param sharded A pointer to the sharded dict to initialize
+ * @param capacity The initial capacity of the sharded dict, split evenly among the shards
+ * @param shard_count The number of shards, rounded up to a power of 2, a few times the number of threads keeps
+ * threads from colliding on the same shard
+ * @return True if the initialization succeeded, false otherwise
+ * @note All shards share one random hash seed, a key is hashed once and the hash both picks its shard and is
+ * passed on to the shard's dict
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_InitSharded(Dict_Sharded(Tkey_, Tval_) * sharded, size_t capacity, size_t shard_count) {
+    shard_count = shard_count & (shard_count - 1) ? CTL_NEXT_POW2(shard_count) : CTL_MAX(shard_count, (size_t)1);
 
-        dict->metadata_group[group_index].slot[bitpos] = (Dict_Metadata){.hlow = hash, .occupied = true};
-        dict->size += 1;
+    sharded->shard_count = shard_count;
+    sharded->block       = Dict_Malloc(shard_count * sizeof(Dict_Shard(Tkey_, Tval_)) + 64);
+    if (sharded->block == NULL) {
+        return false;
     }
 
-    if (2 * dict->size >= dict->capacity) {
-        if (!Dict_Grow(dict)) {
-            // Growth allocation failed
+    sharded->shard = (void*)(((uintptr_t)sharded->block + 63) & ~(uintptr_t)63);
+
+    uint64_t seed = Dict_RandomSeed(sharded);
+    for (size_t shard_index = 0; shard_index < shard_count; shard_index++) {
+        sharded->shard[shard_index].lock = 0;
+        if (!Dict_InitWithSeed(&sharded->shard[shard_index].dict, capacity / shard_count, seed)) {
+            while (shard_index-- > 0) {
+                Dict_Uninit(&sharded->shard[shard_index].dict);
+            }
+
+            Dict_Free(sharded->block);
             return false;
         }
     }
@@ -456,195 +2734,446 @@ static inline bool Dict_Set(Dict(Tkey_, Tval_) * dict, Tkey key, Tval val) {
 }
 
 /**
- * @brief Clears the dict of all elements, resetting to a clean state
- * @param dict The dict to clear
+ * @brief Uninitializes a sharded dict, freeing every shard, no other thread may be using it
  */
 CTL_OVERLOADABLE
-static inline void Dict_Clear(Dict(Tkey_, Tval_) * dict) {
-    Dict_Uninit(dict);
-    Dict_Init(dict, 0);
+static inline void Dict_Uninit(Dict_Sharded(Tkey_, Tval_) * sharded) {
+    for (size_t shard_index = 0; shard_index < sharded->shard_count; shard_index++) {
+        Dict_Uninit(&sharded->shard[shard_index].dict);
+    }
+
+    Dict_Free(sharded->block);
+    sharded->shard_count = 0;
+    sharded->shard       = NULL;
+    sharded->block       = NULL;
 }
 
 /**
- * @brief Iteratively enumerate keys within the dict, returns a pointer to the next occupied key given an
- * existing key in the dict
- * @param dict The dictionary to enumerate
- * @param prev_key The previous key, passing NULL will give provide the first key in the dict
- * @return Returns NULL if @param prev_key was the last key in the dict, otherwise returns @param prev_key
- * successor
+ * @brief Gets the shard responsible for the key with @param hash, see @ref Dict_PartitionIndex
  */
 CTL_OVERLOADABLE
-static inline Tkey* Dict_EnumerateKeys(Dict(Tkey_, Tval_) * dict, Tkey* prev_key) {
-    const size_t max_group_index = dict->capacity / 16;
+static inline Dict_Shard(Tkey_, Tval_) * Dict_ShardOf(Dict_Sharded(Tkey_, Tval_) * sharded, uint64_t hash) {
+    return &sharded->shard[Dict_PartitionIndex(hash, sharded->shard_count)];
+}
 
-    if (prev_key == NULL) {
-        if (dict->metadata_group[0].slot[0].occupied) {
-            // return the first one if no previous one was supplied and it's occupied
-            return &dict->key_group[0].key[0];
-        } else {
-            // set prevKey to the first one since we know it's empty
-            prev_key = &dict->key_group[0].key[0];
-        }
+/**
+ * @brief Looks up a value given a key in a sharded dict, safe to call from multiple threads at once
+ * @param sharded The sharded dict to search for the key
+ * @param key The key to look for
+ * @param out_val A pointer to where to write the value found at @param key, if found
+ * @return True if @param key was found and the value was written to @param out_val, false otherwise
+ * @note There's no Dict_GetPtr for sharded dicts, the value is copied out while the shard is locked since another
+ * thread could move or remove it as soon as the lock is released
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Get(Dict_Sharded(Tkey_, Tval_) * sharded, Tkey key, Tval* out_val) {
+    uint64_t hash = Dict_Hash(&sharded->shard[0].dict, key);
+    Dict_Shard(Tkey_, Tval_)* shard = Dict_ShardOf(sharded, hash);
+
+    Dict_Lock(&shard->lock);
+    Dict_MigrateStep(&shard->dict);
+    Tval* val = Dict_FindValue(&shard->dict, key, hash);
+    if (val != NULL) {
+        *out_val = *val;
     }
+    Dict_Unlock(&shard->lock);
 
-    // find the group index and slot index
-    uintptr_t first_key_addr = (uintptr_t)&dict->key_group[0].key[0];
-    uintptr_t delta_bytes    = (uintptr_t)prev_key - first_key_addr;
-    size_t    group_index    = delta_bytes / sizeof(Dict_KeyGroup(Tkey_, Tval_));
-    size_t    slot_index     = (delta_bytes - group_index * sizeof(Dict_KeyGroup(Tkey_, Tval_))) / sizeof(Tkey);
+    return val != NULL;
+}
 
-    // check if there is another slot in this group that is occupied after prev key
-    uint16_t occupied_mask       = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
-    uint16_t clear_mask          = (1ull << ((uint32_t)slot_index + 1)) - 1;
-    uint16_t upper_occupied_mask = occupied_mask & ~clear_mask;
+/**
+ * @brief Stores a <key, value> pair to a sharded dict, replacing the value if the key is present, safe to call from
+ * multiple threads at once
+ * @return True if the <key, value> pair was stored, false if the key's shard had to grow and couldn't
+ * @note Only the key's shard is locked, and only it grows if it's full
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Set(Dict_Sharded(Tkey_, Tval_) * sharded, Tkey key, Tval val) {
+    uint64_t hash = Dict_Hash(&sharded->shard[0].dict, key);
+    Dict_Shard(Tkey_, Tval_)* shard = Dict_ShardOf(sharded, hash);
 
-    if (upper_occupied_mask) {
-        int next_slot = ffs(upper_occupied_mask) - 1;
-        return &dict->key_group[group_index].key[next_slot];
+    Dict_Lock(&shard->lock);
+    bool stored = Dict_SetHashed(&shard->dict, key, hash, val);
+    Dict_Unlock(&shard->lock);
+
+    return stored;
+}
+
+/**
+ * @brief Removes a key and its associated value from a sharded dict, safe to call from multiple threads at once
+ * @return True if @param key was found and removed, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Remove(Dict_Sharded(Tkey_, Tval_) * sharded, Tkey key) {
+    Dict_Shard(Tkey_, Tval_)* shard = Dict_ShardOf(sharded, Dict_Hash(&sharded->shard[0].dict, key));
+
+    Dict_Lock(&shard->lock);
+    bool removed = Dict_Remove(&shard->dict, key);
+    Dict_Unlock(&shard->lock);
+
+    return removed;
+}
+
+/**
+ * @brief Counts the entries of a sharded dict, locking one shard at a time
+ * @note The count is only exact if no other thread adds or removes entries meanwhile
+ */
+CTL_OVERLOADABLE
+static inline size_t Dict_Size(Dict_Sharded(Tkey_, Tval_) * sharded) {
+    size_t size = 0;
+    for (size_t shard_index = 0; shard_index < sharded->shard_count; shard_index++) {
+        Dict_Lock(&sharded->shard[shard_index].lock);
+        size += sharded->shard[shard_index].dict.size;
+        Dict_Unlock(&sharded->shard[shard_index].lock);
     }
 
-    // if none were set we need to increment the group index and check the next group
-    group_index += 1;
+    return size;
+}
 
-    for (; group_index < max_group_index; group_index += 1) {
-        occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+/* --- Read-copy-update dicts --- */
+
+// a dict for many readers and rare writers, readers look up an immutable published table without taking any lock,
+// writers copy it, change the copy and publish it in its place, see Dict_InitRcu
+typedef struct Dict_Rcu(Tkey_, Tval_) {
+    Dict(Tkey_, Tval_) * current; // the published table, only ever swapped, never changed
+    uint64_t         epoch;       // bumped by every publish, a reader records the epoch it started reading in
+    uint32_t         writer_lock;
+    size_t           reader_count;
+    Dict_ReaderSlot* reader;
+    void*            block; // the allocation reader was aligned within
+}
+Dict_Rcu(Tkey_, Tval_);
 
-        if (occupied_mask) {
-            int next_slot = ffs(occupied_mask) - 1;
-            return &dict->key_group[group_index].key[next_slot];
+/**
+ * @brief Initializes a read-copy-update dict, where reads never write to memory shared with another thread and
+ * writes copy the whole table, for tables that are read all the time and only change now and then
+ * @param rcu A pointer to the dict to initialize
+ * @param capacity The initial capacity of the dict
+ * @param reader_count The number of reader threads, each one passes its own index below reader_count to
+ * Dict_ReadBegin/Dict_ReadEnd/Dict_Get
+ * @return True if the initialization succeeded, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_InitRcu(Dict_Rcu(Tkey_, Tval_) * rcu, size_t capacity, size_t reader_count) {
+    rcu->current      = Dict_New(Tkey_, Tval_)(capacity);
+    rcu->epoch        = 1;
+    rcu->writer_lock  = 0;
+    rcu->reader_count = reader_count;
+    rcu->block        = Dict_Malloc(reader_count * sizeof(Dict_ReaderSlot) + 64);
+
+    if (rcu->current == NULL || rcu->block == NULL) {
+        if (rcu->current != NULL) {
+            Dict_Delete(rcu->current);
         }
+
+        Dict_Free(rcu->block);
+        return false;
     }
 
-    return NULL;
+    rcu->reader = (void*)(((uintptr_t)rcu->block + 63) & ~(uintptr_t)63);
+    return true;
 }
 
 /**
- * @brief Iteratively enumerate values within the dict, returns a pointer to the next occupied value given
- * an existing value in the dict
- * @param dict The dictionary to enumerate
- * @param prev_value The previous value, passing NULL will give provide the first value in the dict
- * @return Returns NULL if @param prev_value was the last value in the dict, otherwise returns @param prev_value
- * successor
+ * @brief Uninitializes a read-copy-update dict, no other thread may be using it
  */
 CTL_OVERLOADABLE
-static inline Tval* Dict_EnumerateValues(Dict(Tkey_, Tval_) * dict, Tval* prev_value) {
-    const size_t max_group_index = dict->capacity / 16;
+static inline void Dict_Uninit(Dict_Rcu(Tkey_, Tval_) * rcu) {
+    Dict_Delete(rcu->current);
+    Dict_Free(rcu->block);
 
-    if (prev_value == NULL) {
-        if (dict->metadata_group[0].slot[0].occupied) {
-            // return the first one if no previous one was supplied and it's occupied
-            return &dict->value_group[0].val[0];
-        } else {
-            // set prevKey to the first one since we know it's empty
-            prev_value = &dict->value_group[0].val[0];
-        }
+    rcu->current = NULL;
+    rcu->reader  = NULL;
+    rcu->block   = NULL;
+}
+
+/**
+ * @brief Starts a read of the dict by reader @param reader_index, the returned table stays valid (and unchanged)
+ * until the matching @ref Dict_ReadEnd, however many times it's replaced meanwhile
+ * @param rcu The dict to read
+ * @param reader_index The calling thread's reader index, no two threads may read with the same index at once
+ * @return The published table, only to be read with Dict_Get/Dict_GetPtr/Dict_EnumerateKeys etc.
+ * @note The only write is to the reader's own slot, a single store (and fence), which makes it cheap to keep a
+ * read open for a whole batch of lookups, e.g. a request
+ * @note A published table never has a Dict_Incremental migration running, so looking it up doesn't change it
+ * @warning Lookups still update Dict_Stats counters, which then race between readers of the same table
+ */
+CTL_OVERLOADABLE
+static inline Dict(Tkey_, Tval_) * Dict_ReadBegin(Dict_Rcu(Tkey_, Tval_) * rcu, size_t reader_index) {
+    // the slot has to be visible before the table is loaded, or a writer could miss it and free the table under us
+    uint64_t epoch = __atomic_load_n(&rcu->epoch, __ATOMIC_RELAXED);
+    __atomic_store_n(&rcu->reader[reader_index].epoch, epoch, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&rcu->current, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Ends a read started with @ref Dict_ReadBegin, the table it returned mustn't be used after this
+ */
+CTL_OVERLOADABLE
+static inline void Dict_ReadEnd(Dict_Rcu(Tkey_, Tval_) * rcu, size_t reader_index) {
+    __atomic_store_n(&rcu->reader[reader_index].epoch, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Looks up a value given a key in a read-copy-update dict, a whole read in one call
+ * @param rcu The dict to search for the key
+ * @param reader_index The calling thread's reader index, see @ref Dict_ReadBegin
+ * @param key The key to look for
+ * @param out_val A pointer to where to write the value found at @param key, if found
+ * @return True if @param key was found and the value was written to @param out_val, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Get(Dict_Rcu(Tkey_, Tval_) * rcu, size_t reader_index, Tkey key, Tval* out_val) {
+    Dict(Tkey_, Tval_)* dict = Dict_ReadBegin(rcu, reader_index);
+    Tval* val                = Dict_FindValue(dict, key, Dict_Hash(dict, key));
+    if (val != NULL) {
+        *out_val = *val;
     }
+    Dict_ReadEnd(rcu, reader_index);
 
-    // find the group index and slot index
-    uintptr_t first_key_addr = (uintptr_t)&dict->value_group[0].val[0];
-    uintptr_t delta_bytes    = (uintptr_t)prev_value - first_key_addr;
-    size_t    group_index    = delta_bytes / sizeof(Dict_ValueGroup(Tkey_, Tval_));
-    size_t    slot_index     = (delta_bytes - group_index * sizeof(Dict_ValueGroup(Tkey_, Tval_))) / sizeof(Tkey);
+    return val != NULL;
+}
 
-    // check if there is another slot in this group that is occupied after prev key
-    uint16_t occupied_mask       = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
-    uint16_t clear_mask          = (1ull << ((uint32_t)slot_index + 1)) - 1;
-    uint16_t upper_occupied_mask = occupied_mask & ~clear_mask;
+/**
+ * @brief Starts a write, taking the writer lock and copying the published table for the caller to change with the
+ * regular dict functions, the copy is published by @ref Dict_Publish
+ * @return The copy, or NULL if it couldn't be allocated (the lock is released again)
+ */
+CTL_OVERLOADABLE
+static inline Dict(Tkey_, Tval_) * Dict_WriteBegin(Dict_Rcu(Tkey_, Tval_) * rcu) {
+    Dict_Lock(&rcu->writer_lock);
 
-    if (upper_occupied_mask) {
-        int next_slot = ffs(upper_occupied_mask) - 1;
-        assert(group_index < max_group_index);
-        return &dict->value_group[group_index].val[next_slot];
+    // only the struct is allocated, Dict_Copy gives it its table, Dict_Malloc zeroes it so there's no table to free
+    Dict(Tkey_, Tval_)* dict = Dict_Malloc(sizeof(*dict));
+    if (dict == NULL || !Dict_Copy(rcu->current, dict)) {
+        Dict_Free(dict);
+        Dict_Unlock(&rcu->writer_lock);
+        return NULL;
     }
 
-    // if none were set we need to increment the group index and check the next group
-    group_index += 1;
+    return dict;
+}
 
-    for (; group_index < max_group_index; group_index += 1) {
-        occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+/**
+ * @brief Publishes the table from @ref Dict_WriteBegin in place of the current one and releases the writer lock,
+ * new reads see it right away, the old table is freed once every read that might still be using it has ended
+ * @note The wait for readers spins (and yields), it lasts as long as the longest read in progress
+ */
+CTL_OVERLOADABLE
+static inline void Dict_Publish(Dict_Rcu(Tkey_, Tval_) * rcu, Dict(Tkey_, Tval_) * dict) {
+    // readers must not have to help a migration along
+    Dict_FinishMigration(dict);
+
+    Dict(Tkey_, Tval_)* old = __atomic_exchange_n(&rcu->current, dict, __ATOMIC_SEQ_CST);
+    uint64_t epoch          = __atomic_add_fetch(&rcu->epoch, 1, __ATOMIC_SEQ_CST);
+
+    // a reader that started in an earlier epoch may have loaded the old table, one that started in this epoch loaded
+    // the new one
+    for (size_t reader_index = 0; reader_index < rcu->reader_count; reader_index++) {
+        for (int spins = 0;; spins++) {
+            uint64_t reader_epoch = __atomic_load_n(&rcu->reader[reader_index].epoch, __ATOMIC_ACQUIRE);
+            if (reader_epoch == 0 || reader_epoch >= epoch) {
+                break;
+            }
 
-        if (occupied_mask) {
-            int next_slot = ffs(occupied_mask) - 1;
-            assert(group_index < max_group_index);
-            return &dict->value_group[group_index].val[next_slot];
+            if (spins < Dict_Lock_Spins) {
+                _mm_pause();
+            } else {
+                sched_yield();
+            }
         }
     }
 
-    return NULL;
+    Dict_Delete(old);
+    Dict_Unlock(&rcu->writer_lock);
 }
 
+/**
+ * @brief Stores a <key, value> pair to a read-copy-update dict, a whole write (copy, change and publish) in one call
+ * @return True if the <key, value> pair was stored, false if an allocation failed (the dict is then unchanged)
+ * @note Every call copies the table, batch changes with @ref Dict_WriteBegin and @ref Dict_Publish instead
+ */
 CTL_OVERLOADABLE
-static inline bool Dict_Grow(Dict(Tkey_, Tval_) * dict) {
-    const size_t max_group_index = dict->capacity / 16;
+static inline bool Dict_Set(Dict_Rcu(Tkey_, Tval_) * rcu, Tkey key, Tval val) {
+    Dict(Tkey_, Tval_)* dict = Dict_WriteBegin(rcu);
+    if (dict == NULL) {
+        return false;
+    }
 
-    // create a new temp dict to use as a temporary
-    Dict(Tkey_, Tval_) dict_new;
-    if (!Dict_Init(&dict_new, dict->capacity)) {
+    if (!Dict_Set(dict, key, val)) {
+        Dict_Delete(dict);
+        Dict_Unlock(&rcu->writer_lock);
+        return false;
+    }
+
+    Dict_Publish(rcu, dict);
+    return true;
+}
+
+/**
+ * @brief Removes a key from a read-copy-update dict, a whole write in one call, see @ref Dict_Set
+ * @return True if @param key was found and removed, false if it wasn't there or an allocation failed
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Remove(Dict_Rcu(Tkey_, Tval_) * rcu, Tkey key) {
+    Dict(Tkey_, Tval_)* dict = Dict_WriteBegin(rcu);
+    if (dict == NULL) {
         return false;
     }
 
-    // iterate through occupied slots and add them to the new dict to rehash then entries
-    size_t   group_index   = 0;
-    uint16_t clear_mask    = 0;
-    uint16_t occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+    if (!Dict_Remove(dict, key)) {
+        Dict_Delete(dict);
+        Dict_Unlock(&rcu->writer_lock);
+        return false;
+    }
 
-    while (group_index < max_group_index) {
-        uint16_t next_occupied_mask = occupied_mask & ~clear_mask;
+    Dict_Publish(rcu, dict);
+    return true;
+}
 
-        if (next_occupied_mask) {
-            int  next_slot = ffs(next_occupied_mask) - 1;
-            Tkey key       = dict->key_group[group_index].key[next_slot];
-            Tval val       = dict->value_group[group_index].val[next_slot];
+/* --- Partitioned aggregation --- */
 
-            if (!Dict_Set(&dict_new, key, val)) {
-                Dict_Uninit(&dict_new);
-                return false;
-            }
+// a dict built by several threads at once, each worker inserts into its own dict per partition, then each partition
+// is merged on its own, see Dict_InitPartitioned
+typedef struct Dict_Partitioned(Tkey_, Tval_) {
+    size_t worker_count;
+    size_t partition_count;
+    Dict(Tkey_, Tval_) * partition; // worker w's dict for partition p is partition[w * partition_count + p]
+}
+Dict_Partitioned(Tkey_, Tval_);
 
-            // adjust the clear mask to exclude already processed entries
-            clear_mask = (1 << (next_slot + 1)) - 1;
-        } else {
-            // increment the group_index and reset the clear_mask
-            group_index += 1;
+/**
+ * @brief Initializes a partitioned dict, for building one table on several threads (e.g. a group by), radix
+ * partitioned by hash so every worker has a private dict per partition and the partitions can be merged in parallel
+ * @param parts A pointer to the partitioned dict to initialize
+ * @param worker_count The number of threads that insert into it, each passes its own index below worker_count
+ * @param partition_count The number of partitions, rounded up to a power of 2, a few times the worker count keeps
+ * merging balanced
+ * @param capacity The initial capacity of every worker's dicts, split evenly among the partitions
+ * @return True if the initialization succeeded, false otherwise
+ * @note Usage: every worker calls Dict_Upsert(parts, worker_index, ...) for its share of the input, then (after all of
+ * them are done) every partition is merged with @ref Dict_MergePartition, any thread merging any partition. The
+ * result is worker 0's dicts, Dict_Get(parts, ...) looks keys up in them
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_InitPartitioned(
+    Dict_Partitioned(Tkey_, Tval_) * parts,
+    size_t worker_count,
+    size_t partition_count,
+    size_t capacity) {
+    partition_count =
+        partition_count & (partition_count - 1) ? CTL_NEXT_POW2(partition_count) : CTL_MAX(partition_count, (size_t)1);
+
+    parts->worker_count    = worker_count;
+    parts->partition_count = partition_count;
+    parts->partition       = Dict_Malloc(worker_count * partition_count * sizeof(Dict(Tkey_, Tval_)));
+    if (parts->partition == NULL) {
+        return false;
+    }
+
+    // one seed for every dict, a key's hash then picks its partition and is reused when merging
+    uint64_t seed = Dict_RandomSeed(parts);
+    for (size_t dict_index = 0; dict_index < worker_count * partition_count; dict_index++) {
+        if (!Dict_InitWithSeed(&parts->partition[dict_index], capacity / partition_count, seed)) {
+            while (dict_index-- > 0) {
+                Dict_Uninit(&parts->partition[dict_index]);
+            }
 
-            occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
-            clear_mask    = 0;
+            Dict_Free(parts->partition);
+            return false;
         }
     }
 
-    // free the old dict, copy the new one's pointers
-    Dict_Uninit(dict);
-    *dict = dict_new;
-
     return true;
 }
 
+/**
+ * @brief Uninitializes a partitioned dict, freeing every worker's dicts
+ */
 CTL_OVERLOADABLE
-static inline bool Dict_Copy(Dict(Tkey_, Tval_) * src_dict, Dict(Tkey_, Tval_) * dst_dict) {
-    // new_dict will be manipulated to prevent breaking dst_dict in the event of an allocation failure
-    Dict(Tkey_, Tval_) new_dict;
-    if (!Dict_Init(&new_dict, src_dict->capacity - 1)) {
-        return false;
+static inline void Dict_Uninit(Dict_Partitioned(Tkey_, Tval_) * parts) {
+    for (size_t dict_index = 0; dict_index < parts->worker_count * parts->partition_count; dict_index++) {
+        Dict_Uninit(&parts->partition[dict_index]);
     }
 
-    // figure out the total size of the source dict's memory
-    size_t group_count         = src_dict->capacity / 16;
-    size_t metadata_group_size = group_count * sizeof(Dict_MetadataGroup);
-    size_t key_group_size      = group_count * sizeof(Dict_KeyGroup(Tkey_, Tval_));
-    size_t value_group_size    = group_count * sizeof(Dict_ValueGroup(Tkey_, Tval_));
-    size_t total_size          = metadata_group_size + key_group_size + value_group_size;
+    Dict_Free(parts->partition);
+    parts->partition = NULL;
+}
 
-    // copy the source dict's data to the new dict's data
-    memcpy(new_dict.metadata_group, src_dict->metadata_group, total_size);
-    new_dict.size = src_dict->size;
+/**
+ * @brief Gets worker @param worker_index's dict for the partition the key with @param hash belongs to
+ */
+CTL_OVERLOADABLE
+static inline Dict(Tkey_, Tval_) *
+    Dict_PartitionOf(Dict_Partitioned(Tkey_, Tval_) * parts, size_t worker_index, uint64_t hash) {
+    return &parts->partition[worker_index * parts->partition_count + Dict_PartitionIndex(hash, parts->partition_count)];
+}
 
-    // free the dst_dict, then copy new_dict to it so that it's now the duplicate
-    Dict_Uninit(dst_dict);
-    *dst_dict = new_dict;
+/**
+ * @brief Gets a pointer to a key's value in worker @param worker_index's dicts, inserting the key with a zeroed value
+ * if it isn't present, see @ref Dict_Upsert
+ * @note Only the worker itself may call this with its index, different workers can call it at the same time
+ */
+CTL_OVERLOADABLE
+static inline Tval* Dict_Upsert(Dict_Partitioned(Tkey_, Tval_) * parts, size_t worker_index, Tkey key, bool* inserted) {
+    uint64_t hash = Dict_Hash(&parts->partition[0], key);
+    return Dict_UpsertHashed(Dict_PartitionOf(parts, worker_index, hash), key, hash, inserted);
+}
+
+/**
+ * @brief Merges every worker's dict for partition @param partition_index into worker 0's with @ref Dict_Merge,
+ * freeing the merged dicts, different partitions can be merged by different threads at the same time
+ * @param combine Called for keys in both dicts to fold a worker's value into worker 0's, see @ref Dict_Merge
+ * @return True if the partition was merged, false if an allocation failed
+ * @note The workers must be done inserting, the merged dicts are left empty
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_MergePartition(
+    Dict_Partitioned(Tkey_, Tval_) * parts,
+    size_t partition_index,
+    void (*combine)(Tval* dst_val, Tval* src_val, void* ctx),
+    void* ctx) {
+    Dict(Tkey_, Tval_)* dst_dict = &parts->partition[partition_index];
+
+    for (size_t worker_index = 1; worker_index < parts->worker_count; worker_index++) {
+        Dict(Tkey_, Tval_)* src_dict = &parts->partition[worker_index * parts->partition_count + partition_index];
+
+        // merging into the bigger of the two dicts moves fewer entries
+        if (src_dict->size > dst_dict->size) {
+            Dict(Tkey_, Tval_) swap;
+            Dict_Assign(&swap, dst_dict);
+            Dict_Assign(dst_dict, src_dict);
+            Dict_Assign(src_dict, &swap);
+        }
+
+        if (!Dict_Merge(dst_dict, src_dict, combine, ctx)) {
+            return false;
+        }
+
+        Dict_Uninit(src_dict);
+        if (!Dict_InitWithSeed(src_dict, 0, dst_dict->seed)) {
+            return false;
+        }
+    }
 
     return true;
 }
 
+/**
+ * @brief Looks up a value given a key in a partitioned dict whose partitions have been merged, see @ref Dict_Get
+ */
+CTL_OVERLOADABLE
+static inline bool Dict_Get(Dict_Partitioned(Tkey_, Tval_) * parts, Tkey key, Tval* out_val) {
+    uint64_t hash = Dict_Hash(&parts->partition[0], key);
+    Tval*    val  = Dict_FindValue(Dict_PartitionOf(parts, 0, hash), key, hash);
+    if (val != NULL) {
+        *out_val = *val;
+        return true;
+    }
+
+    return false;
+}
+
 // cleanup macros
 #undef Dict_KeyType
 #undef Dict_KeyType_Alias
@@ -653,13 +3182,47 @@ static inline bool Dict_Copy(Dict(Tkey_, Tval_) * src_dict, Dict(Tkey_, Tval_) *
 #undef Dict_ValueType_Alias
 
 #undef Dict_CompareKey
+#undef Dict_CompareKey_Default
+#undef Dict_SimdKeys
+#undef Dict_MatchKeys
 #undef Dict_HashKey
+#undef Dict_HashKeySeeded
+#undef Dict_MixHash
+#undef Dict_HashUsesSeed
+#undef Dict_Probing
+#undef Dict_Layout
+#undef Dict_MaxLoad
+#undef Dict_CacheHash
+#undef Dict_Incremental
+#undef Dict_MigrateGroups
+#undef Dict_GrowInPlace
+#undef Dict_Inline
+#undef Dict_Stats
+#undef Dict_Mappable
+
+#undef Dict_LookupType
+#undef Dict_HashLookup
+#undef Dict_HashLookupSeeded
+#undef Dict_CompareLookup
 
 #undef Dict_Malloc
 #undef Dict_Realloc
 #undef Dict_Free
 #undef CTL_DICT_DEFAULT_ALLOC
 
+#undef Dict_KeyAt
+#undef Dict_ValAt
+#undef Dict_KeyGroupStride
+#undef Dict_ValGroupStride
+#undef Dict_KeySlotStride
+#undef Dict_ValSlotStride
+#undef Dict_GroupSize
+#undef Dict_EntryAt
+#undef Dict_HashAt
+#undef Dict_EntryCapacity
+#undef Dict_LiveWords
+#undef Dict_StatsAdd
+
 #undef Tkey
 #undef Tval
 
@@ -0,0 +1,444 @@
+#pragma once
+
+/* --- SwissTable internals shared by Dict and Set --- */
+/* The built-in key hashes and compares, the 16-slot metadata groups and the SIMD compares that find a group's
+ * candidate slots. These don't depend on a template's types so they're only defined once, whichever container is
+ * included first */
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../common/ctl.h"
+
+// a non-owning, not necessarily NUL terminated string, usable as a key type or to look up char* keys
+typedef struct {
+    const char* ptr;
+    size_t      len;
+} Dict_StrView;
+
+// splitmix64's finalizer
+static inline uint64_t Dict_Mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Gets a seed for a dict's hashes from the TSC and @param salt, an address that ASLR moves around
+ * @note Not cryptographic, it only has to keep keys from being picked ahead of time to collide
+ */
+static inline uint64_t Dict_RandomSeed(const void* salt) {
+    return Dict_Mix64(__rdtsc() ^ ((uint64_t)(uintptr_t)salt << 17));
+}
+
+static inline uint64_t Dict_Hash64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccd;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53;
+    x ^= x >> 33;
+    return x;
+}
+
+static inline uint64_t Dict_HashKey_U8(uint8_t key, uint64_t seed) {
+    return Dict_Hash64(key ^ seed);
+}
+
+static inline uint64_t Dict_HashKey_U16(uint16_t key, uint64_t seed) {
+    return Dict_Hash64(key ^ seed);
+}
+
+static inline uint64_t Dict_HashKey_U32(uint32_t key, uint64_t seed) {
+    return Dict_Hash64(key ^ seed);
+}
+
+static inline uint64_t Dict_HashKey_U64(uint64_t key, uint64_t seed) {
+    return Dict_Hash64(key ^ seed);
+}
+
+static inline uint64_t Dict_HashKey_F32(float key, uint64_t seed) {
+    union {
+        float    f32;
+        uint32_t u32;
+    } conv = {.f32 = key};
+
+    _Static_assert(sizeof(float) == sizeof(uint32_t), "float isn't 32 bits");
+    return Dict_Hash64(conv.u32 ^ seed);
+}
+
+static inline uint64_t Dict_HashKey_F64(double key, uint64_t seed) {
+    union {
+        double   f64;
+        uint64_t u64;
+    } conv = {.f64 = key};
+
+    _Static_assert(sizeof(double) == sizeof(uint64_t), "double isn't 64 bits");
+    return Dict_Hash64(conv.u64 ^ seed);
+}
+
+static inline uint64_t Dict_Read64(const uint8_t* ptr) {
+    uint64_t val;
+    memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+static inline uint64_t Dict_Read32(const uint8_t* ptr) {
+    uint32_t val;
+    memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+// 64x64 -> 128 bit multiply, folding the high half into the low half
+static inline uint64_t Dict_MulFold(uint64_t x, uint64_t y) {
+    __uint128_t product = (__uint128_t)x * y;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+}
+
+/**
+ * @brief Word at a time hash of an arbitrary byte string, based on wyhash (public domain)
+ * @param data The bytes to hash
+ * @param len The number of bytes to hash
+ * @param seed Selects the hash function, the same bytes hash differently under different seeds
+ */
+static inline uint64_t Dict_HashBytes_Wy(const void* data, size_t len, uint64_t seed) {
+    const uint64_t secret[4] = {0xa0761d6478bd642f, 0xe7037ed1a0b428db, 0x8ebc6af09c88c6e3, 0x589965cc75374cc3};
+
+    // the secrets are public, an input word equal to one would zero a multiply and collide no matter the seed, so
+    // the multiplies are keyed with the seed as well
+    const uint64_t key[4] = {secret[0], secret[1] ^ seed, secret[2] ^ seed, secret[3] ^ seed};
+
+    const uint8_t* ptr = data;
+    uint64_t       a, b;
+
+    seed ^= Dict_MulFold(seed ^ secret[0], secret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            // two (possibly overlapping) reads from each end cover all of 4-16 bytes
+            size_t mid = (len >> 3) << 2;
+            a          = (Dict_Read32(ptr) << 32) | Dict_Read32(ptr + mid);
+            b          = (Dict_Read32(ptr + len - 4) << 32) | Dict_Read32(ptr + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((uint64_t)ptr[0] << 16) | ((uint64_t)ptr[len >> 1] << 8) | ptr[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t remaining = len;
+
+        if (remaining > 48) {
+            // three independent lanes keep the multipliers busy
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+
+            do {
+                seed  = Dict_MulFold(Dict_Read64(ptr) ^ key[1], Dict_Read64(ptr + 8) ^ seed);
+                seed1 = Dict_MulFold(Dict_Read64(ptr + 16) ^ key[2], Dict_Read64(ptr + 24) ^ seed1);
+                seed2 = Dict_MulFold(Dict_Read64(ptr + 32) ^ key[3], Dict_Read64(ptr + 40) ^ seed2);
+                ptr += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16) {
+            seed = Dict_MulFold(Dict_Read64(ptr) ^ key[1], Dict_Read64(ptr + 8) ^ seed);
+            ptr += 16;
+            remaining -= 16;
+        }
+
+        // the last 16 bytes, overlapping what was already consumed if needed
+        a = Dict_Read64(ptr + remaining - 16);
+        b = Dict_Read64(ptr + remaining - 8);
+    }
+
+    __uint128_t product = (__uint128_t)(a ^ key[1]) * (b ^ seed);
+    return Dict_MulFold((uint64_t)product ^ secret[0] ^ len, (uint64_t)(product >> 64) ^ key[1]);
+}
+
+/**
+ * @brief Hashes @param len bytes at @param data with @param seed, this is the hash used for strings
+ * @note Uses the wyhash based hash, which is keyed by the seed
+ */
+static inline uint64_t Dict_HashBytes(const void* data, size_t len, uint64_t seed) {
+    return Dict_HashBytes_Wy(data, len, seed);
+}
+
+/**
+ * @brief Hashes a string of known length, identical to Dict_HashKey_Str(str, seed) when
+ * @param len == strlen(@param str)
+ */
+static inline uint64_t Dict_HashKey_StrN(const char* str, size_t len, uint64_t seed) {
+    return Dict_HashBytes(str, len, seed);
+}
+
+static inline uint64_t Dict_HashKey_Str(const char* str, uint64_t seed) {
+    return Dict_HashBytes(str, strlen(str), seed);
+}
+
+static inline uint64_t Dict_HashKey_StrView(Dict_StrView view, uint64_t seed) {
+    return Dict_HashBytes(view.ptr, view.len, seed);
+}
+
+// the built-in seeded hashes, picked by the key's type
+#define Dict_HashKey_Builtin(key, seed) \
+    _Generic((key),                         \
+        uint8_t:        Dict_HashKey_U8,    \
+        int8_t:         Dict_HashKey_U8,    \
+        uint16_t:       Dict_HashKey_U16,   \
+        int16_t:        Dict_HashKey_U16,   \
+        uint32_t:       Dict_HashKey_U32,   \
+        int32_t:        Dict_HashKey_U32,   \
+        uint64_t:       Dict_HashKey_U64,   \
+        int64_t:        Dict_HashKey_U64,   \
+        float:          Dict_HashKey_F32,   \
+        double:         Dict_HashKey_F64,   \
+        char*:          Dict_HashKey_Str,   \
+        Dict_StrView:   Dict_HashKey_StrView)((key), (seed))
+
+static inline bool Dict_CompareKey_U8(uint8_t k1, uint8_t k2) {
+    return k1 == k2;
+}
+
+static inline bool Dict_CompareKey_U16(uint16_t k1, uint16_t k2) {
+    return k1 == k2;
+}
+
+static inline bool Dict_CompareKey_U32(uint32_t k1, uint32_t k2) {
+    return k1 == k2;
+}
+
+static inline bool Dict_CompareKey_U64(uint64_t k1, uint64_t k2) {
+    return k1 == k2;
+}
+
+static inline bool Dict_CompareKey_F32(float k1, float k2) {
+    return k1 == k2;
+}
+
+static inline bool Dict_CompareKey_F64(double k1, double k2) {
+    return k1 == k2;
+}
+
+static inline bool Dict_CompareKey_Str(char* k1, char* k2) {
+    return !strcmp(k1, k2);
+}
+
+static inline bool Dict_CompareKey_StrView(Dict_StrView k1, Dict_StrView k2) {
+    return k1.len == k2.len && !memcmp(k1.ptr, k2.ptr, k1.len);
+}
+
+// compares a view against a NUL terminated string without reading past the end of either, a view holding a NUL
+// never equals a string
+static inline bool Dict_CompareKey_StrViewStr(Dict_StrView view, const char* str) {
+    return strnlen(str, view.len + 1) == view.len && !memcmp(str, view.ptr, view.len);
+}
+
+// the built-in compares, plain equality for integers and floats, strcmp for char*
+#define Dict_CompareKey_Builtin(k1, k2) \
+    (_Generic((k1), \
+        uint8_t:        Dict_CompareKey_U8,     \
+        int8_t:         Dict_CompareKey_U8,     \
+        uint16_t:       Dict_CompareKey_U16,    \
+        int16_t:        Dict_CompareKey_U16,    \
+        uint32_t:       Dict_CompareKey_U32,    \
+        int32_t:        Dict_CompareKey_U32,    \
+        uint64_t:       Dict_CompareKey_U64,    \
+        int64_t:        Dict_CompareKey_U64,    \
+        float:          Dict_CompareKey_F32,    \
+        double:         Dict_CompareKey_F64,    \
+        char*:          Dict_CompareKey_Str,    \
+        Dict_StrView:   Dict_CompareKey_StrView \
+    )((k1), (k2)))
+
+typedef union {
+    __m128d  d128;
+    __m128i  i128;
+    uint64_t u64[2];
+    uint32_t u32[4];
+    uint16_t u16[8];
+    uint8_t  u8[16];
+} Dict_v128;
+
+typedef union {
+    struct {
+        uint8_t hlow     : 7;
+        uint8_t occupied : 1;
+    };
+    uint8_t u8;
+} Dict_Metadata;
+
+typedef union {
+    Dict_Metadata slot[16];
+    Dict_v128     v128;
+} Dict_MetadataGroup;
+
+// unoccupied slots are either empty (never used, terminates a probe) or deleted (a tombstone, probes continue past it)
+enum {
+    Dict_Metadata_Empty   = 0x00,
+    Dict_Metadata_Deleted = 0x7F,
+};
+
+static inline uint16_t Dict_CompareBitmask(Dict_MetadataGroup metadata, uint8_t expected) {
+    __m128i  exp_vector = _mm_set1_epi8(expected);
+    __m128i  comparison = _mm_cmpeq_epi8(exp_vector, metadata.v128.i128);
+    uint16_t mask       = _mm_movemask_epi8(comparison);
+
+    return mask;
+}
+
+static inline uint16_t Dict_OccupiedBitmask(Dict_MetadataGroup metadata) {
+    uint16_t mask = _mm_movemask_epi8(metadata.v128.i128);
+    return mask;
+}
+
+/**
+ * @brief Widens a hash narrower than 64 bits (i.e. a user supplied hash) with a fibonacci hash, this spreads every
+ * input bit into the high bits which pick the group
+ */
+static inline uint64_t Dict_WidenHash(uint32_t hash) {
+    return (uint64_t)hash * 0x9e3779b97f4a7c15;
+}
+
+/**
+ * @brief Gets the group index (H1) for a hash, taken from the high bits so it's independent of the tag
+ * @param group_count The number of groups in the table, must be a power of 2
+ */
+static inline size_t Dict_GroupIndex(uint64_t hash, size_t group_count) {
+    // shifting the tag bits out first keeps both shifts below 64 when there's a single group
+    return (hash >> 7) >> (57 - __builtin_ctzll(group_count));
+}
+
+/**
+ * @brief Gets the metadata for an occupied slot (H2), the tag comes from the low 7 bits of the hash
+ */
+static inline Dict_Metadata Dict_OccupiedMetadata(uint64_t hash) {
+    return (Dict_Metadata){.hlow = hash & 0x7F, .occupied = true};
+}
+
+// the group probing policies, see Dict_Probing in dict.h
+#define Dict_Probing_Linear     1
+#define Dict_Probing_Triangular 2
+#define Dict_Probing_Stride     3
+
+// the position of a lookup within its probe sequence over groups
+typedef struct {
+    size_t index;
+    size_t mask;
+    size_t stride;
+} Dict_Probe;
+
+/**
+ * @brief Starts the probe sequence for @param hash in a table of @param group_count groups
+ * @param probing The probing policy, one of the Dict_Probing_* constants
+ */
+static inline Dict_Probe Dict_StartProbe(int probing, uint64_t hash, size_t group_count) {
+    Dict_Probe probe = {
+        .index = Dict_GroupIndex(hash, group_count),
+        .mask  = group_count - 1,
+        // any odd stride visits every group of a power of 2 sized table
+        .stride = probing == Dict_Probing_Stride ? (hash >> 7) | 1 : 0,
+    };
+
+    return probe;
+}
+
+/**
+ * @brief Advances @param probe to the next group in its probe sequence, every policy visits every group exactly
+ * once in the first group_count steps
+ * @param probing The probing policy @param probe was started with
+ */
+static inline void Dict_NextProbe(int probing, Dict_Probe* probe) {
+    if (probing == Dict_Probing_Linear) {
+        probe->index = (probe->index + 1) & probe->mask;
+    } else if (probing == Dict_Probing_Triangular) {
+        probe->stride += 1;
+        probe->index = (probe->index + probe->stride) & probe->mask;
+    } else {
+        probe->index = (probe->index + probe->stride) & probe->mask;
+    }
+}
+
+static inline uint16_t Dict_EmptyBitmask(Dict_MetadataGroup metadata) {
+    return Dict_CompareBitmask(metadata, Dict_Metadata_Empty);
+}
+
+/**
+ * @brief Converts every occupied slot in the group to deleted and every deleted slot to empty, this is the first
+ * step of an in-place rehash where deleted then means 'occupied, but needs to be re-placed'
+ */
+static inline void Dict_PrepareRehash(Dict_MetadataGroup* metadata) {
+    __m128i occupied = _mm_cmplt_epi8(metadata->v128.i128, _mm_setzero_si128());
+    metadata->v128.i128 = _mm_and_si128(occupied, _mm_set1_epi8(Dict_Metadata_Deleted));
+}
+
+/**
+ * @brief Marks an occupied slot as unoccupied, avoiding a tombstone if no probe sequence can pass through the slot
+ * @param metadata The slot's group
+ * @return True if the slot was left as a tombstone, which the caller counts
+ */
+static inline bool Dict_VacateSlot(Dict_MetadataGroup* metadata, size_t slot_index) {
+    // probes only continue past full groups, so if the group already has an empty slot no probe sequence relies
+    // on this slot being occupied and it can be emptied directly
+    if (Dict_EmptyBitmask(*metadata)) {
+        metadata->slot[slot_index].u8 = Dict_Metadata_Empty;
+        return false;
+    } else {
+        metadata->slot[slot_index].u8 = Dict_Metadata_Deleted;
+        return true;
+    }
+}
+
+/**
+ * @brief Compares @param key against all 16 keys of a group at once, one SSE2 compare for 8-bit keys and one or two
+ * AVX-512/AVX2 compares for 16 and 32-bit keys (two and four SSE2 ones without)
+ * @param keys The group's 16 keys, stored contiguously
+ * @param key_size The size of a key, 1, 2 or 4 bytes
+ * @param key The key to look for
+ * @return A mask of the group's slots holding @param key, unoccupied slots can still hold a stale copy of it
+ */
+static inline uint16_t Dict_KeyGroupBitmask(const void* keys, size_t key_size, const void* key) {
+    uint32_t bits = 0;
+    memcpy(&bits, key, CTL_MIN(key_size, sizeof(bits)));
+
+    if (key_size == 1) {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(keys), _mm_set1_epi8((char)bits)));
+    } else if (key_size == 2) {
+#if defined(__AVX512BW__) && defined(__AVX512VL__)
+        return _mm256_cmpeq_epi16_mask(_mm256_loadu_si256(keys), _mm256_set1_epi16((short)bits));
+#elif defined(__AVX2__)
+        __m256i equal = _mm256_cmpeq_epi16(_mm256_loadu_si256(keys), _mm256_set1_epi16((short)bits));
+        return _mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(equal), _mm256_extracti128_si256(equal, 1)));
+#else
+        __m128i needle = _mm_set1_epi16((short)bits);
+        __m128i equal0 = _mm_cmpeq_epi16(_mm_loadu_si128(keys), needle);
+        __m128i equal1 = _mm_cmpeq_epi16(_mm_loadu_si128(keys + 16), needle);
+        return _mm_movemask_epi8(_mm_packs_epi16(equal0, equal1));
+#endif
+    } else if (key_size == 4) {
+#if defined(__AVX512F__)
+        return _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(keys), _mm512_set1_epi32((int)bits));
+#elif defined(__AVX2__)
+        __m256i needle = _mm256_set1_epi32((int)bits);
+        __m256i equal0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(keys), needle);
+        __m256i equal1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(keys + 32), needle);
+        // packing works within 128-bit lanes, the permute puts the results back in slot order
+        __m256i equal = _mm256_permute4x64_epi64(_mm256_packs_epi32(equal0, equal1), 0xD8);
+        return _mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(equal), _mm256_extracti128_si256(equal, 1)));
+#else
+        __m128i needle = _mm_set1_epi32((int)bits);
+        __m128i equal0 = _mm_packs_epi32(
+            _mm_cmpeq_epi32(_mm_loadu_si128(keys), needle), _mm_cmpeq_epi32(_mm_loadu_si128(keys + 16), needle));
+        __m128i equal1 = _mm_packs_epi32(
+            _mm_cmpeq_epi32(_mm_loadu_si128(keys + 32), needle), _mm_cmpeq_epi32(_mm_loadu_si128(keys + 48), needle));
+        return _mm_movemask_epi8(_mm_packs_epi16(equal0, equal1));
+#endif
+    }
+
+    return 0;
+}
@@ -0,0 +1,551 @@
+/* --- Templated Intrusive Dictionary Type --- */
+/* Usage:
+
+    -- Required --
+        IDict_Type:      The entry type, a struct owned by the user that holds its own key and an IDict_Link
+        IDict_KeyType:   The key type, hashed, used to lookup entries
+        IDict_KeyField:  The name of the entry's member holding its key
+        IDict_LinkField: The name of the entry's IDict_Link member, which the table maintains
+
+    -- Possibly Required --
+        IDict_Type_Alias: Alias for the entry type
+
+        IDict_CompareKey(key1, key2): A comparison function for the key type
+        IDict_HashKey(key):           A hash function for the key type that results in a uint64_t (or uint32_t),
+                                      defaults provided, a uint64_t result is mixed before use as in Dict
+
+    -- Optional --
+        IDict_MaxLoad(capacity): The most entries (including tombstones) a table of capacity slots holds before it
+                                 grows, must be less than capacity, defaults to 7/8ths of the capacity
+
+        IDict_Malloc(bytes): An allocator function (obeying ISO C's malloc/calloc semantics) that zero's memory
+        IDict_Free(ptr):     A free function (obeying ISO C's free semantics)
+
+    -- Notes --
+        An intrusive dict indexes entries it doesn't own, its table holds Dict's metadata groups and a pointer per
+        slot and the entries stay wherever the user put them. Nothing is copied in or out, growing the table moves
+        8 bytes per entry however big the entries are, and the pointers IDict_Find returns stay valid until the
+        user frees the entry, no matter how the table changes
+        The table stores each entry's full hash in its link, growing reads it from there instead of rehashing the
+        key, and lookups compare it before paying for a key compare
+        An entry can be in one intrusive dict per IDict_Link member, its key and link must not be changed while it's
+        in one
+        The built-in hashes and compares are Dict's (see dict.h), seeded per table
+        Including idict.h with none of the required macros defined only declares IDict_Link, so it can be included
+        ahead of the entry type's definition
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../common/ctl.h"
+#include "dict_common.h"
+
+#if !defined(CTL_IDICT_INCLUDED)
+#    define CTL_IDICT_INCLUDED
+
+#    define IDict(T)      CONCAT(IDict, T)
+#    define IDict_New(T)  CONCAT(IDict_New, T)
+#    define IDict_Iter(T) CONCAT(IDictIter, T)
+
+/* Iterates over every entry in the dict, declaring name as a pointer to the current entry, break and continue work
+ * as they do in a regular for loop. The dict must not have entries added or removed during the loop */
+#    define IDict_ForEach(dict, name)                                                                \
+        for (typeof(IDict_IterStart(dict)) _idict_it = IDict_IterStart(dict);                       \
+             _idict_it.entry == NULL && IDict_IterNext(&_idict_it);)                                \
+            for (typeof(_idict_it.entry) name = _idict_it.entry; _idict_it.entry != NULL; _idict_it.entry = NULL)
+
+/* these are internal -- don't use these */
+#    define IDict_EntryGroup(T) CONCAT(IDictEntryGroup, T)
+
+// the part of an entry an intrusive dict maintains, embedded in the entry as its IDict_LinkField member
+typedef struct {
+    uint64_t hash; // the entry's key's hash in the dict it's in
+} IDict_Link;
+#endif
+
+// included without a specialization only to declare IDict_Link, e.g. ahead of the entry type's definition
+#if defined(IDict_Type) || defined(IDict_KeyType) || defined(IDict_KeyField) || defined(IDict_LinkField)
+
+#    if !defined(IDict_Type) || !defined(IDict_KeyType)
+#        error "IDict template requires entry and key types to be defined"
+#    endif
+
+#    if !defined(IDict_KeyField) || !defined(IDict_LinkField)
+#        error "IDict template requires the entry's key and link members to be named"
+#    endif
+
+#    if !defined(IDict_MaxLoad)
+#        define IDict_MaxLoad(capacity) ((capacity) - (capacity) / 8)
+#    endif
+
+// the built-in hashes are already mixed, a custom 64-bit one might not be (see dict.h), a custom hash ignores the seed
+#    if !defined(IDict_HashKey)
+#        define IDict_HashKeySeeded(key, seed) Dict_HashKey_Builtin(key, seed)
+#        define IDict_MixHash(hash)            (hash)
+#    else
+#        define IDict_HashKeySeeded(key, seed) ((void)(seed), IDict_HashKey(key))
+#        define IDict_MixHash(hash)            Dict_Mix64(hash)
+#    endif
+
+#    if !defined(IDict_CompareKey)
+#        define IDict_CompareKey(k1, k2) Dict_CompareKey_Builtin(k1, k2)
+#    endif
+
+#    if !defined(IDict_Malloc)
+#        if !defined(CTL_IDICT_DEFAULT_ALLOC)
+#            define CTL_IDICT_DEFAULT_ALLOC
+#        endif
+#        define IDict_Malloc(bytes) calloc(1, bytes)
+#    endif
+
+#    if !defined(IDict_Free)
+#        if !defined(CTL_IDICT_DEFAULT_ALLOC)
+#            warning "Non-default malloc used with default free"
+#        endif
+#        define IDict_Free free
+#    endif
+
+#    if defined(CTL_IDICT_DEFAULT_ALLOC)
+#        include <stdlib.h>
+#    endif
+
+// useful macros internally
+
+#    define T    IDict_Type
+#    define Tkey IDict_KeyType
+
+#    if !defined(IDict_Type_Alias)
+#        define T_ T
+#    else
+#        define T_ IDict_Type_Alias
+#    endif
+
+typedef struct IDict_EntryGroup(T_) {
+    T* entry[16];
+}
+IDict_EntryGroup(T_);
+
+#    define IDict_EntryAt(table, group, slot) ((table)->entry_group[(group)].entry[(slot)])
+#    define IDict_KeyOf(entry)                ((entry)->IDict_KeyField)
+#    define IDict_HashOf(entry)               ((entry)->IDict_LinkField.hash)
+
+typedef struct IDict(T_) {
+    size_t capacity;
+    size_t size;
+    size_t tombstones;
+    // mixed into the built-in key hashes, entries are placed by seeded hashes so it can't change once there are any
+    uint64_t seed;
+    IDict_EntryGroup(T_) * entry_group;
+    Dict_MetadataGroup* metadata_group;
+}
+IDict(T_);
+
+// a cursor over the entries of an intrusive dict, see IDict_IterStart/IDict_IterNext
+typedef struct IDict_Iter(T_) {
+    IDict(T_) * dict;
+    size_t   group_index;
+    uint16_t occupied_mask; // occupied slots of group_index that haven't been visited yet
+    T*       entry;
+}
+IDict_Iter(T_);
+
+/**
+ * @brief Initializes an intrusive dict for use with a given hash seed
+ * @param dict A pointer to the dict to initialize
+ * @param capacity The initial capacity of the dict
+ * @param seed The seed mixed into the built-in key hashes
+ * @return True if the initialization succeeded, false otherwise
+ * @note If capacity is not of the form 2^N * 16, it is rounded up to the next suitable form (e.g. 0 -> 16,
+ * 17 -> 32, etc)
+ */
+CTL_OVERLOADABLE
+static inline bool IDict_InitWithSeed(IDict(T_) * dict, size_t capacity, uint64_t seed) {
+    dict->capacity   = 16 * CTL_NEXT_POW2(capacity / 16);
+    dict->size       = 0;
+    dict->tombstones = 0;
+    dict->seed       = seed;
+
+    // the metadata, then the entry pointers, in one block
+    size_t group_count = dict->capacity / 16;
+    void*  block       = IDict_Malloc(group_count * (sizeof(Dict_MetadataGroup) + sizeof(IDict_EntryGroup(T_))));
+    if (block == NULL) {
+        return false;
+    }
+
+    dict->metadata_group = block;
+    dict->entry_group    = block + group_count * sizeof(Dict_MetadataGroup);
+    return true;
+}
+
+/**
+ * @brief Initializes an intrusive dict for use
+ * @param dict A pointer to the dict to initialize
+ * @param capacity The initial capacity of the dict
+ * @return True if the initialization succeeded, false otherwise
+ * @note If capacity is not of the form 2^N * 16, it is rounded up to the next suitable form (e.g. 0 -> 16,
+ * 17 -> 32, etc)
+ * @note The dict gets a random hash seed, so keys can't be chosen ahead of time to all collide in it
+ */
+CTL_OVERLOADABLE
+static inline bool IDict_Init(IDict(T_) * dict, size_t capacity) {
+    return IDict_InitWithSeed(dict, capacity, Dict_RandomSeed(dict));
+}
+
+/**
+ * @brief Allocates and initializes an intrusive dict on the heap
+ * @param capacity The initial capacity of the dict
+ * @return A pointer to the dict on the heap, or NULL if the allocation failed
+ */
+static inline IDict(T_) * IDict_New(T_)(size_t capacity) {
+    IDict(T_)* dict = IDict_Malloc(sizeof(*dict));
+    if (!IDict_Init(dict, capacity)) {
+        IDict_Free(dict);
+        return NULL;
+    }
+
+    return dict;
+}
+
+/**
+ * @brief Uninitializes an intrusive dict, which then allows it to be discarded without leaking memory
+ * @param dict The dict to uninitialize
+ * @note The entries belong to the user and aren't touched
+ * @warning This function should only be used in conjunction with @ref IDict_Init
+ */
+CTL_OVERLOADABLE
+static inline void IDict_Uninit(IDict(T_) * dict) {
+    IDict_Free(dict->metadata_group);
+    dict->metadata_group = NULL;
+}
+
+/**
+ * @brief Deletes an intrusive dict that was allocated on the heap
+ * @param dict The dict to delete
+ * @warning This function should only be used in conjunction with @ref IDict_New
+ */
+CTL_OVERLOADABLE
+static inline void IDict_Delete(IDict(T_) * dict) {
+    IDict_Uninit(dict);
+    IDict_Free(dict);
+}
+
+/**
+ * @brief Computes the hash the dict uses for @param key
+ * @return The 64-bit hash of @param key, hashes from a custom IDict_HashKey are mixed (64-bit) or widened (narrower)
+ */
+CTL_OVERLOADABLE
+static inline uint64_t IDict_Hash(IDict(T_) * dict, Tkey key) {
+    if (sizeof(IDict_HashKeySeeded(key, dict->seed)) >= sizeof(uint64_t)) {
+        return IDict_MixHash(IDict_HashKeySeeded(key, dict->seed));
+    } else {
+        return Dict_WidenHash(IDict_HashKeySeeded(key, dict->seed));
+    }
+}
+
+/**
+ * @brief Looks for the entry with @param key in the dict, probing groups at triangular number offsets as Dict does
+ * by default, a tag match's full hash (in its entry's link) is compared before its key
+ * @return True if the entry was found and its slot written out, false if it wasn't and the first unoccupied slot on
+ * its probe sequence (where it would be inserted) was written out instead
+ */
+CTL_OVERLOADABLE
+static inline bool
+IDict_FindSlot(IDict(T_) * dict, Tkey key, uint64_t hash, size_t* group_index_out, size_t* slot_index_out) {
+    Dict_Probe    probe             = Dict_StartProbe(Dict_Probing_Triangular, hash, dict->capacity / 16);
+    Dict_Metadata expected_metadata = Dict_OccupiedMetadata(hash);
+
+    bool   found_available = false;
+    size_t available_group = 0;
+    int    available_slot  = 0;
+
+    // the table always has an empty slot, so the probe terminates
+    while (true) {
+        size_t   group_index = probe.index;
+        uint16_t mask        = Dict_CompareBitmask(dict->metadata_group[group_index], expected_metadata.u8);
+
+        for (int imask = mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos   = ffs(imask) - 1;
+            T* entry = IDict_EntryAt(dict, group_index, bitpos);
+            if (IDict_HashOf(entry) == hash && IDict_CompareKey(key, IDict_KeyOf(entry))) {
+                *group_index_out = group_index;
+                *slot_index_out  = bitpos;
+                return true;
+            }
+        }
+
+        uint16_t occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+        if (!found_available && occupied_mask != 0xFFFF) {
+            found_available = true;
+            available_group = group_index;
+            available_slot  = ffs(~occupied_mask) - 1;
+        }
+
+        // deleted slots don't end the probe, the entry may have been placed after the slot was occupied
+        if (Dict_EmptyBitmask(dict->metadata_group[group_index])) {
+            *group_index_out = available_group;
+            *slot_index_out  = available_slot;
+            return false;
+        }
+
+        Dict_NextProbe(Dict_Probing_Triangular, &probe);
+    }
+}
+
+/**
+ * @brief Moves the dict's entry pointers into a new table with @param capacity slots, which also drops its
+ * tombstones. Each entry's hash is read from its link, no key is hashed or compared
+ * @return True if the dict was moved, false if the allocation failed (the dict is left untouched)
+ */
+CTL_OVERLOADABLE
+static inline bool IDict_GrowTo(IDict(T_) * dict, size_t capacity) {
+    IDict(T_) dict_new;
+    if (!IDict_InitWithSeed(&dict_new, capacity - 1, dict->seed)) {
+        return false;
+    }
+
+    const size_t max_group_index = dict->capacity / 16;
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        uint16_t occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[group_index]);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos         = ffs(imask) - 1;
+            T*       entry = IDict_EntryAt(dict, group_index, bitpos);
+            uint64_t hash  = IDict_HashOf(entry);
+
+            Dict_Probe probe = Dict_StartProbe(Dict_Probing_Triangular, hash, dict_new.capacity / 16);
+            uint16_t   new_occupied_mask;
+            while ((new_occupied_mask = Dict_OccupiedBitmask(dict_new.metadata_group[probe.index])) == 0xFFFF) {
+                Dict_NextProbe(Dict_Probing_Triangular, &probe);
+            }
+
+            int new_slot = ffs(~new_occupied_mask) - 1;
+
+            IDict_EntryAt(&dict_new, probe.index, new_slot)     = entry;
+            dict_new.metadata_group[probe.index].slot[new_slot] = Dict_OccupiedMetadata(hash);
+        }
+    }
+
+    dict_new.size = dict->size;
+
+    IDict_Uninit(dict);
+    *dict = dict_new;
+    return true;
+}
+
+/**
+ * @brief Grows the dict so that it can hold @param count entries without growing again, if the dict can already
+ * hold @param count entries do nothing
+ * @return True if the dict was able to reserve enough space, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool IDict_Reserve(IDict(T_) * dict, size_t count) {
+    size_t capacity = dict->capacity;
+    while (count > IDict_MaxLoad(capacity)) {
+        capacity *= 2;
+    }
+
+    if (capacity == dict->capacity) {
+        return true;
+    }
+
+    return IDict_GrowTo(dict, capacity);
+}
+
+/**
+ * @brief Marks an occupied slot as unoccupied, avoiding a tombstone if no probe sequence can pass through the slot
+ */
+CTL_OVERLOADABLE
+static inline void IDict_RemoveSlot(IDict(T_) * dict, size_t group_index, size_t slot_index) {
+    dict->tombstones += Dict_VacateSlot(&dict->metadata_group[group_index], slot_index);
+    dict->size -= 1;
+}
+
+/**
+ * @brief Adds an entry to the dict, unless an entry with the same key is already in it
+ * @param dict The dict to add to
+ * @param entry The entry to add, its key must be set, its link is written by the dict
+ * @return @param entry if it was added, the entry already in the dict with its key if there is one (@param entry is
+ * then left out and untouched), or NULL if growing the dict failed
+ * @note Only the pointer is stored, @param entry has to stay where it is until it's removed from the dict
+ */
+CTL_OVERLOADABLE
+static inline T* IDict_Insert(IDict(T_) * dict, T* entry) {
+    uint64_t hash = IDict_Hash(dict, IDict_KeyOf(entry));
+    size_t   group_index, slot_index;
+    if (IDict_FindSlot(dict, IDict_KeyOf(entry), hash, &group_index, &slot_index)) {
+        return IDict_EntryAt(dict, group_index, slot_index);
+    }
+
+    if (dict->metadata_group[group_index].slot[slot_index].u8 == Dict_Metadata_Deleted) {
+        dict->tombstones -= 1;
+    }
+
+    IDict_HashOf(entry)                                = hash;
+    IDict_EntryAt(dict, group_index, slot_index)       = entry;
+    dict->metadata_group[group_index].slot[slot_index] = Dict_OccupiedMetadata(hash);
+    dict->size += 1;
+
+    if (dict->size + dict->tombstones > IDict_MaxLoad(dict->capacity)) {
+        // mostly tombstones, moving the entries to a table of the same capacity frees enough space without growing
+        size_t capacity = 2 * dict->size <= IDict_MaxLoad(dict->capacity) ? dict->capacity : 2 * dict->capacity;
+        if (!IDict_GrowTo(dict, capacity)) {
+            // take the entry back out rather than leave the dict over its max load
+            IDict_RemoveSlot(dict, group_index, slot_index);
+            return NULL;
+        }
+    }
+
+    return entry;
+}
+
+/**
+ * @brief Finds the entry with a key
+ * @param dict The dict to search
+ * @param key The key to look for
+ * @return A pointer to the entry with @param key, or NULL if there's none, the pointer is the one the entry was
+ * added with so it stays valid as the dict grows
+ */
+CTL_OVERLOADABLE
+static inline T* IDict_Find(IDict(T_) * dict, Tkey key) {
+    size_t group_index, slot_index;
+    if (IDict_FindSlot(dict, key, IDict_Hash(dict, key), &group_index, &slot_index)) {
+        return IDict_EntryAt(dict, group_index, slot_index);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Removes the entry with a key from the dict
+ * @param dict The dict to remove from
+ * @param key The key of the entry to remove
+ * @return The removed entry, which the user can then free or reuse, or NULL if there was none with @param key
+ */
+CTL_OVERLOADABLE
+static inline T* IDict_Remove(IDict(T_) * dict, Tkey key) {
+    size_t group_index, slot_index;
+    if (IDict_FindSlot(dict, key, IDict_Hash(dict, key), &group_index, &slot_index)) {
+        T* entry = IDict_EntryAt(dict, group_index, slot_index);
+        IDict_RemoveSlot(dict, group_index, slot_index);
+        return entry;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Removes an entry known to be in the dict, found by its address and the hash in its link rather than by
+ * its key, so no key is hashed or compared
+ * @param dict The dict to remove from
+ * @param entry The entry to remove
+ * @return True if @param entry was in the dict and was removed, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool IDict_Unlink(IDict(T_) * dict, T* entry) {
+    uint64_t      hash              = IDict_HashOf(entry);
+    Dict_Probe    probe             = Dict_StartProbe(Dict_Probing_Triangular, hash, dict->capacity / 16);
+    Dict_Metadata expected_metadata = Dict_OccupiedMetadata(hash);
+
+    while (true) {
+        size_t   group_index = probe.index;
+        uint16_t mask        = Dict_CompareBitmask(dict->metadata_group[group_index], expected_metadata.u8);
+
+        for (int imask = mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+            if (IDict_EntryAt(dict, group_index, bitpos) == entry) {
+                IDict_RemoveSlot(dict, group_index, bitpos);
+                return true;
+            }
+        }
+
+        if (Dict_EmptyBitmask(dict->metadata_group[group_index])) {
+            return false;
+        }
+
+        Dict_NextProbe(Dict_Probing_Triangular, &probe);
+    }
+}
+
+/**
+ * @brief Removes every entry from the dict, resetting to a clean state
+ * @param dict The dict to clear
+ * @note The entries belong to the user and aren't touched
+ */
+CTL_OVERLOADABLE
+static inline void IDict_Clear(IDict(T_) * dict) {
+    IDict_Uninit(dict);
+    IDict_Init(dict, 0);
+}
+
+/**
+ * @brief Creates a cursor positioned before the first entry of the dict, advance it with @ref IDict_IterNext
+ * @param dict The dict to iterate over
+ * @return The cursor
+ */
+CTL_OVERLOADABLE
+static inline IDict_Iter(T_) IDict_IterStart(IDict(T_) * dict) {
+    IDict_Iter(T_) iter = {
+        .dict          = dict,
+        .group_index   = 0,
+        .occupied_mask = Dict_OccupiedBitmask(dict->metadata_group[0]),
+        .entry         = NULL,
+    };
+
+    return iter;
+}
+
+/**
+ * @brief Advances the cursor to the next entry, skipping whole groups without occupied slots
+ * @param iter The cursor to advance
+ * @return True if the cursor's entry points at the next entry, false if there are no entries left
+ */
+CTL_OVERLOADABLE
+static inline bool IDict_IterNext(IDict_Iter(T_) * iter) {
+    const size_t max_group_index = iter->dict->capacity / 16;
+
+    while (iter->occupied_mask == 0) {
+        if (iter->group_index + 1 >= max_group_index) {
+            iter->group_index = max_group_index;
+            return false;
+        }
+
+        iter->group_index += 1;
+        iter->occupied_mask = Dict_OccupiedBitmask(iter->dict->metadata_group[iter->group_index]);
+    }
+
+    int slot_index = __builtin_ctz(iter->occupied_mask);
+    iter->occupied_mask &= iter->occupied_mask - 1;
+
+    iter->entry = IDict_EntryAt(iter->dict, iter->group_index, slot_index);
+    return true;
+}
+
+#endif
+
+// cleanup macros
+#undef IDict_Type
+#undef IDict_Type_Alias
+#undef IDict_KeyType
+#undef IDict_KeyField
+#undef IDict_LinkField
+
+#undef IDict_CompareKey
+#undef IDict_HashKey
+#undef IDict_HashKeySeeded
+#undef IDict_MixHash
+#undef IDict_MaxLoad
+
+#undef IDict_Malloc
+#undef IDict_Free
+#undef CTL_IDICT_DEFAULT_ALLOC
+
+#undef IDict_EntryAt
+#undef IDict_KeyOf
+#undef IDict_HashOf
+
+#undef T
+#undef Tkey
+#undef T_
@@ -0,0 +1,726 @@
+/* --- Templated Set Type --- */
+/* Usage:
+
+    -- Required --
+        Set_KeyType: The key type for the set, hashed
+
+    -- Possibly Required --
+        Set_KeyType_Alias: Alias for the key type
+
+        Set_CompareKey(key1, key2): A comparison function for the key type
+        Set_HashKey(key):           A hash function for the key type that results in a uint64_t (or uint32_t),
+                                    defaults provided, a uint64_t result is mixed before use as in Dict
+
+    -- Optional --
+        Set_MaxLoad(capacity): The most keys (including tombstones) a table of capacity slots holds before it grows,
+                               must be less than capacity, defaults to 7/8ths of the capacity
+
+        Set_Malloc(bytes): An allocator function (obeying ISO C's malloc/calloc semantics) that zero's memory
+        Set_Free(ptr):     A free function (obeying ISO C's free semantics)
+
+    -- Notes --
+        A set is a dict without values, it shares Dict's metadata groups, probing and built-in hashes and compares
+        (see dict.h), a table is 16 metadata bytes and 16 keys per group. The built-in hashes are seeded per set
+        With the default compare, 8 and 16-bit integer keys are compared against all of a group's candidates at once
+        with SIMD compares, as Dict does
+        Set_Union/Set_Intersect/Set_Difference build a set out of two others, visiting the smaller set's keys a group
+        at a time and probing the larger set for them, so they cost the size of the smaller set (plus copying the
+        larger one's table for a union, or a difference with the smaller set removed)
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../common/ctl.h"
+#include "dict_common.h"
+
+#if !defined(CTL_SET_INCLUDED)
+#    define CTL_SET_INCLUDED
+
+#    define Set(Tkey)      CONCAT(Set, Tkey)
+#    define Set_New(Tkey)  CONCAT(Set_New, Tkey)
+#    define Set_Iter(Tkey) CONCAT(SetIter, Tkey)
+
+/* Iterates over every key in the set, declaring name as a pointer to the current key, break and continue work as they
+ * do in a regular for loop. The set must not have keys added or removed during the loop */
+#    define Set_ForEach(set, name)                                                                      \
+        for (typeof(Set_IterStart(set)) _set_iter = Set_IterStart(set);                                 \
+             _set_iter.key == NULL && Set_IterNext(&_set_iter);)                                        \
+            for (typeof(_set_iter.key) name = _set_iter.key; _set_iter.key != NULL; _set_iter.key = NULL)
+
+/* these are internal -- don't use these */
+#    define Set_KeyGroup(Tkey) CONCAT(SetKeyGroup, Tkey)
+#endif
+
+#if !defined(Set_KeyType)
+#    error "Set template requires a key type to be defined"
+#endif
+
+#if !defined(Set_MaxLoad)
+#    define Set_MaxLoad(capacity) ((capacity) - (capacity) / 8)
+#endif
+
+// the built-in hashes are already mixed, a custom 64-bit one might not be (see dict.h), a custom hash ignores the seed
+#if !defined(Set_HashKey)
+#    define Set_HashKeySeeded(key, seed) Dict_HashKey_Builtin(key, seed)
+#    define Set_MixHash(hash)            (hash)
+#else
+#    define Set_HashKeySeeded(key, seed) ((void)(seed), Set_HashKey(key))
+#    define Set_MixHash(hash)            Dict_Mix64(hash)
+#endif
+
+#if !defined(Set_CompareKey)
+// the default compare is plain equality for integer keys, which lets Set_Find compare whole groups of them at once
+#    define Set_CompareKey_Default
+#    define Set_CompareKey(k1, k2) Dict_CompareKey_Builtin(k1, k2)
+#endif
+
+#if !defined(Set_Malloc)
+#    if !defined(CTL_SET_DEFAULT_ALLOC)
+#        define CTL_SET_DEFAULT_ALLOC
+#    endif
+#    define Set_Malloc(bytes) calloc(1, bytes)
+#endif
+
+#if !defined(Set_Free)
+#    if !defined(CTL_SET_DEFAULT_ALLOC)
+#        warning "Non-default malloc used with default free"
+#    endif
+#    define Set_Free free
+#endif
+
+#if defined(CTL_SET_DEFAULT_ALLOC)
+#    include <stdlib.h>
+#endif
+
+// useful macros internally
+
+#define Tkey Set_KeyType
+
+#if !defined(Set_KeyType_Alias)
+#    define Tkey_ Tkey
+#else
+#    define Tkey_ Set_KeyType_Alias
+#endif
+
+typedef struct Set_KeyGroup(Tkey_) {
+    Tkey key[16];
+}
+Set_KeyGroup(Tkey_);
+
+#define Set_KeyAt(table, group, slot) ((table)->key_group[(group)].key[(slot)])
+
+// 8 and 16-bit integer keys with the default compare are matched against a whole group's keys with SIMD compares
+// instead of one tag match at a time, see Dict_MatchKeys
+#if defined(Set_CompareKey_Default)
+#    define Set_MatchKeys \
+        _Generic((Tkey){0}, \
+            uint8_t:  true, \
+            int8_t:   true, \
+            uint16_t: true, \
+            int16_t:  true, \
+            default:  false)
+#else
+#    define Set_MatchKeys false
+#endif
+
+typedef struct Set(Tkey_) {
+    size_t capacity;
+    size_t size;
+    size_t tombstones;
+    // mixed into the built-in key hashes, keys are placed by seeded hashes so it can't change once there are any
+    uint64_t seed;
+    Set_KeyGroup(Tkey_) * key_group;
+    Dict_MetadataGroup* metadata_group;
+}
+Set(Tkey_);
+
+// a cursor over the keys of a set, see Set_IterStart/Set_IterNext
+typedef struct Set_Iter(Tkey_) {
+    Set(Tkey_) * set;
+    size_t   group_index;
+    uint16_t occupied_mask; // occupied slots of group_index that haven't been visited yet
+    Tkey*    key;
+}
+Set_Iter(Tkey_);
+
+/**
+ * @brief Gets the smallest capacity (of the form 2^N * 16) whose max load holds @param count keys
+ * @note The set is only used to select the instantiation
+ */
+CTL_OVERLOADABLE
+static inline size_t Set_CapacityFor(Set(Tkey_) * set, size_t count) {
+    (void)set;
+
+    size_t capacity = 16;
+    while (count > Set_MaxLoad(capacity)) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+/**
+ * @brief Initializes a set for use with a given hash seed
+ * @param set A pointer to the set to initialize
+ * @param capacity The initial capacity of the set
+ * @param seed The seed mixed into the built-in key hashes
+ * @return True if the initialization succeeded, false otherwise
+ * @note If capacity is not of the form 2^N * 16, it is rounded up to the next suitable form (e.g. 0 -> 16,
+ * 17 -> 32, etc)
+ */
+CTL_OVERLOADABLE
+static inline bool Set_InitWithSeed(Set(Tkey_) * set, size_t capacity, uint64_t seed) {
+    set->capacity   = 16 * CTL_NEXT_POW2(capacity / 16);
+    set->size       = 0;
+    set->tombstones = 0;
+    set->seed       = seed;
+
+    // the metadata, then the keys, in one block
+    size_t group_count = set->capacity / 16;
+    void*  block       = Set_Malloc(group_count * (sizeof(Dict_MetadataGroup) + sizeof(Set_KeyGroup(Tkey_))));
+    if (block == NULL) {
+        return false;
+    }
+
+    set->metadata_group = block;
+    set->key_group      = block + group_count * sizeof(Dict_MetadataGroup);
+    return true;
+}
+
+/**
+ * @brief Initializes a set for use
+ * @param set A pointer to the set to initialize
+ * @param capacity The initial capacity of the set
+ * @return True if the initialization succeeded, false otherwise
+ * @note If capacity is not of the form 2^N * 16, it is rounded up to the next suitable form (e.g. 0 -> 16,
+ * 17 -> 32, etc)
+ * @note The set gets a random hash seed, so keys can't be chosen ahead of time to all collide in it
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Init(Set(Tkey_) * set, size_t capacity) {
+    return Set_InitWithSeed(set, capacity, Dict_RandomSeed(set));
+}
+
+/**
+ * @brief Allocates and initializes a set on the heap
+ * @param capacity The initial capacity of the set
+ * @return A pointer to the set on the heap, or NULL if the allocation failed
+ */
+static inline Set(Tkey_) * Set_New(Tkey_)(size_t capacity) {
+    Set(Tkey_)* set = Set_Malloc(sizeof(*set));
+    if (!Set_Init(set, capacity)) {
+        Set_Free(set);
+        return NULL;
+    }
+
+    return set;
+}
+
+/**
+ * @brief Uninitializes a set, which then allows it to be discarded without leaking memory
+ * @param set The set to uninitialize
+ * @warning This function should only be used in conjunction with @ref Set_Init
+ */
+CTL_OVERLOADABLE
+static inline void Set_Uninit(Set(Tkey_) * set) {
+    Set_Free(set->metadata_group);
+    set->metadata_group = NULL;
+}
+
+/**
+ * @brief Deletes a set that was allocated on the heap
+ * @param set The set to delete
+ * @warning This function should only be used in conjunction with @ref Set_New
+ */
+CTL_OVERLOADABLE
+static inline void Set_Delete(Set(Tkey_) * set) {
+    Set_Uninit(set);
+    Set_Free(set);
+}
+
+/**
+ * @brief Computes the hash the set uses for @param key
+ * @return The 64-bit hash of @param key, hashes from a custom Set_HashKey are mixed (64-bit) or widened (narrower)
+ */
+CTL_OVERLOADABLE
+static inline uint64_t Set_Hash(Set(Tkey_) * set, Tkey key) {
+    if (sizeof(Set_HashKeySeeded(key, set->seed)) >= sizeof(uint64_t)) {
+        return Set_MixHash(Set_HashKeySeeded(key, set->seed));
+    } else {
+        return Dict_WidenHash(Set_HashKeySeeded(key, set->seed));
+    }
+}
+
+/**
+ * @brief Looks for @param key in the set, probing groups at triangular number offsets as Dict does by default
+ * @return True if the key was found and its slot written out, false if it wasn't and the first unoccupied slot on
+ * its probe sequence (where it would be inserted) was written out instead
+ */
+CTL_OVERLOADABLE
+static inline bool
+Set_Find(Set(Tkey_) * set, Tkey key, uint64_t hash, size_t* group_index_out, size_t* slot_index_out) {
+    Dict_Probe    probe             = Dict_StartProbe(Dict_Probing_Triangular, hash, set->capacity / 16);
+    Dict_Metadata expected_metadata = Dict_OccupiedMetadata(hash);
+
+    bool   found_available = false;
+    size_t available_group = 0;
+    int    available_slot  = 0;
+
+    // the table always has an empty slot, so the probe terminates
+    while (true) {
+        size_t   group_index = probe.index;
+        uint16_t mask        = Dict_CompareBitmask(set->metadata_group[group_index], expected_metadata.u8);
+
+        if (Set_MatchKeys && mask != 0) {
+            mask &= Dict_KeyGroupBitmask(&set->key_group[group_index], sizeof(Tkey), &key);
+            if (mask != 0) {
+                *group_index_out = group_index;
+                *slot_index_out  = __builtin_ctz(mask);
+                return true;
+            }
+        }
+
+        for (int imask = mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+            if (Set_CompareKey(key, Set_KeyAt(set, group_index, bitpos))) {
+                *group_index_out = group_index;
+                *slot_index_out  = bitpos;
+                return true;
+            }
+        }
+
+        uint16_t occupied_mask = Dict_OccupiedBitmask(set->metadata_group[group_index]);
+        if (!found_available && occupied_mask != 0xFFFF) {
+            found_available = true;
+            available_group = group_index;
+            available_slot  = ffs(~occupied_mask) - 1;
+        }
+
+        // deleted slots don't end the probe, the key may have been placed after the slot was occupied
+        if (Dict_EmptyBitmask(set->metadata_group[group_index])) {
+            *group_index_out = available_group;
+            *slot_index_out  = available_slot;
+            return false;
+        }
+
+        Dict_NextProbe(Dict_Probing_Triangular, &probe);
+    }
+}
+
+/**
+ * @brief Places a key known not to be in the set into the first unoccupied slot on its probe sequence, without
+ * comparing keys or checking if the set needs to grow
+ * @note Doesn't adjust the set's size, the caller does if it's adding the key rather than moving it
+ */
+CTL_OVERLOADABLE
+static inline void Set_PlaceKey(Set(Tkey_) * set, Tkey key, uint64_t hash) {
+    Dict_Probe probe = Dict_StartProbe(Dict_Probing_Triangular, hash, set->capacity / 16);
+    uint16_t   occupied_mask;
+    while ((occupied_mask = Dict_OccupiedBitmask(set->metadata_group[probe.index])) == 0xFFFF) {
+        Dict_NextProbe(Dict_Probing_Triangular, &probe);
+    }
+
+    size_t group_index = probe.index;
+    int    slot_index  = ffs(~occupied_mask) - 1;
+
+    if (set->metadata_group[group_index].slot[slot_index].u8 == Dict_Metadata_Deleted) {
+        set->tombstones -= 1;
+    }
+
+    Set_KeyAt(set, group_index, slot_index)           = key;
+    set->metadata_group[group_index].slot[slot_index] = Dict_OccupiedMetadata(hash);
+}
+
+/**
+ * @brief Moves the set's keys into a new table with @param capacity slots, which also drops its tombstones
+ * @return True if the set was moved, false if the allocation failed (the set is left untouched)
+ */
+CTL_OVERLOADABLE
+static inline bool Set_GrowTo(Set(Tkey_) * set, size_t capacity) {
+    Set(Tkey_) set_new;
+    if (!Set_InitWithSeed(&set_new, capacity - 1, set->seed)) {
+        return false;
+    }
+
+    const size_t max_group_index = set->capacity / 16;
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        uint16_t occupied_mask = Dict_OccupiedBitmask(set->metadata_group[group_index]);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos   = ffs(imask) - 1;
+            Tkey key = Set_KeyAt(set, group_index, bitpos);
+            Set_PlaceKey(&set_new, key, Set_Hash(set, key));
+        }
+    }
+
+    set_new.size = set->size;
+
+    Set_Uninit(set);
+    *set = set_new;
+    return true;
+}
+
+/**
+ * @brief Grows the set so that it can hold @param count keys without growing again, if the set can already hold
+ * @param count keys do nothing
+ * @return True if the set was able to reserve enough space, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Reserve(Set(Tkey_) * set, size_t count) {
+    size_t capacity = Set_CapacityFor(set, count);
+    if (capacity <= set->capacity) {
+        return true;
+    }
+
+    return Set_GrowTo(set, capacity);
+}
+
+/**
+ * @brief Marks an occupied slot as unoccupied, avoiding a tombstone if no probe sequence can pass through the slot
+ */
+CTL_OVERLOADABLE
+static inline void Set_RemoveSlot(Set(Tkey_) * set, size_t group_index, size_t slot_index) {
+    set->tombstones += Dict_VacateSlot(&set->metadata_group[group_index], slot_index);
+    set->size -= 1;
+}
+
+/**
+ * @brief Inserts a key given its precomputed hash (from @ref Set_Hash), see @ref Set_Insert
+ */
+CTL_OVERLOADABLE
+static inline bool Set_InsertHashed(Set(Tkey_) * set, Tkey key, uint64_t hash) {
+    size_t group_index, slot_index;
+    if (Set_Find(set, key, hash, &group_index, &slot_index)) {
+        return true;
+    }
+
+    if (set->metadata_group[group_index].slot[slot_index].u8 == Dict_Metadata_Deleted) {
+        set->tombstones -= 1;
+    }
+
+    Set_KeyAt(set, group_index, slot_index)           = key;
+    set->metadata_group[group_index].slot[slot_index] = Dict_OccupiedMetadata(hash);
+    set->size += 1;
+
+    if (set->size + set->tombstones > Set_MaxLoad(set->capacity)) {
+        // mostly tombstones, moving the keys to a table of the same capacity frees enough space without growing
+        size_t capacity = 2 * set->size <= Set_MaxLoad(set->capacity) ? set->capacity : 2 * set->capacity;
+        if (!Set_GrowTo(set, capacity)) {
+            // take the key back out rather than leave the set over its max load
+            Set_RemoveSlot(set, group_index, slot_index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Adds a key to the set if it isn't already in it
+ * @param set The set to add to
+ * @param key The key to add
+ * @return True if the key is in the set afterwards, false if it had to be added and growing the set failed
+ * @warning As with Dict_Set, a key equal to one already in the set doesn't replace it
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Insert(Set(Tkey_) * set, Tkey key) {
+    return Set_InsertHashed(set, key, Set_Hash(set, key));
+}
+
+/**
+ * @brief Checks whether a key is in the set
+ * @param set The set to search
+ * @param key The key to look for
+ * @return True if @param key is in the set, false otherwise
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Contains(Set(Tkey_) * set, Tkey key) {
+    size_t group_index, slot_index;
+    return Set_Find(set, key, Set_Hash(set, key), &group_index, &slot_index);
+}
+
+/**
+ * @brief Removes a key from the set
+ * @param set The set to remove from
+ * @param key The key to remove
+ * @return True if @param key was found and removed, false otherwise
+ * @note Removal leaves a tombstone unless the key's group has spare room, tombstones are reused by @ref Set_Insert
+ * and dropped when they make up too much of the table
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Remove(Set(Tkey_) * set, Tkey key) {
+    size_t group_index, slot_index;
+    if (Set_Find(set, key, Set_Hash(set, key), &group_index, &slot_index)) {
+        Set_RemoveSlot(set, group_index, slot_index);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Clears the set of all keys, resetting to a clean state
+ * @param set The set to clear
+ */
+CTL_OVERLOADABLE
+static inline void Set_Clear(Set(Tkey_) * set) {
+    Set_Uninit(set);
+    Set_Init(set, 0);
+}
+
+/**
+ * @brief Creates a cursor positioned before the first key of the set, advance it with @ref Set_IterNext
+ * @param set The set to iterate over
+ * @return The cursor
+ */
+CTL_OVERLOADABLE
+static inline Set_Iter(Tkey_) Set_IterStart(Set(Tkey_) * set) {
+    Set_Iter(Tkey_) iter = {
+        .set           = set,
+        .group_index   = 0,
+        .occupied_mask = Dict_OccupiedBitmask(set->metadata_group[0]),
+        .key           = NULL,
+    };
+
+    return iter;
+}
+
+/**
+ * @brief Advances the cursor to the next key, skipping whole groups without occupied slots
+ * @param iter The cursor to advance
+ * @return True if the cursor's key points at the next key, false if there are no keys left
+ */
+CTL_OVERLOADABLE
+static inline bool Set_IterNext(Set_Iter(Tkey_) * iter) {
+    const size_t max_group_index = iter->set->capacity / 16;
+
+    while (iter->occupied_mask == 0) {
+        if (iter->group_index + 1 >= max_group_index) {
+            iter->group_index = max_group_index;
+            return false;
+        }
+
+        iter->group_index += 1;
+        iter->occupied_mask = Dict_OccupiedBitmask(iter->set->metadata_group[iter->group_index]);
+    }
+
+    int slot_index = __builtin_ctz(iter->occupied_mask);
+    iter->occupied_mask &= iter->occupied_mask - 1;
+
+    iter->key = &Set_KeyAt(iter->set, iter->group_index, slot_index);
+    return true;
+}
+
+/**
+ * @brief Copies @param src_set into @param dst_set, replacing its contents
+ * @return True if the set was copied, false if the allocation failed (@param dst_set is left untouched)
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Copy(Set(Tkey_) * src_set, Set(Tkey_) * dst_set) {
+    // the keys are copied where they are, so the copy has to hash keys with the same seed
+    Set(Tkey_) new_set;
+    if (!Set_InitWithSeed(&new_set, src_set->capacity - 1, src_set->seed)) {
+        return false;
+    }
+
+    size_t group_count = src_set->capacity / 16;
+    memcpy(new_set.metadata_group, src_set->metadata_group, group_count * sizeof(Dict_MetadataGroup));
+    memcpy(new_set.key_group, src_set->key_group, group_count * sizeof(Set_KeyGroup(Tkey_)));
+    new_set.size       = src_set->size;
+    new_set.tombstones = src_set->tombstones;
+
+    Set_Uninit(dst_set);
+    *dst_set = new_set;
+    return true;
+}
+
+/**
+ * @brief Hashes the keys of one of @param set's groups for @param probed and prefetches the group each one's probe
+ * of @param probed starts at, so the probes' cache misses overlap
+ * @param hash Where to write the hash of the key in each occupied slot
+ * @return A mask of the group's occupied slots
+ */
+CTL_OVERLOADABLE
+static inline uint16_t
+Set_HashGroup(Set(Tkey_) * set, size_t group_index, Set(Tkey_) * probed, uint64_t hash[static 16]) {
+    uint16_t occupied_mask = Dict_OccupiedBitmask(set->metadata_group[group_index]);
+
+    for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+        bitpos       = ffs(imask) - 1;
+        hash[bitpos] = Set_Hash(probed, Set_KeyAt(set, group_index, bitpos));
+
+        __builtin_prefetch(&probed->metadata_group[Dict_GroupIndex(hash[bitpos], probed->capacity / 16)]);
+    }
+
+    return occupied_mask;
+}
+
+/**
+ * @brief Computes the union of two sets, every key in either of them
+ * @param dst The set to store the union in, its contents are replaced, it may be @param set_a or @param set_b
+ * @param set_a, set_b The sets to unite
+ * @return True if the union was stored, false if an allocation failed (@param dst is left untouched)
+ * @note Copies the larger set's table, then inserts the smaller set's keys into the copy, which is first grown to
+ * hold both sets' keys
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Union(Set(Tkey_) * dst, Set(Tkey_) * set_a, Set(Tkey_) * set_b) {
+    Set(Tkey_)* small = set_a->size <= set_b->size ? set_a : set_b;
+    Set(Tkey_)* large = set_a->size <= set_b->size ? set_b : set_a;
+
+    // Set_Copy frees the table it replaces, there isn't one yet
+    Set(Tkey_) result = {.metadata_group = NULL};
+    if (!Set_Copy(large, &result)) {
+        return false;
+    }
+
+    // grow at most once, up front, rather than every time the smaller set's keys fill the copy
+    if (!Set_Reserve(&result, set_a->size + set_b->size)) {
+        Set_Uninit(&result);
+        return false;
+    }
+
+    const size_t max_group_index = small->capacity / 16;
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        uint64_t hash[16];
+        uint16_t occupied_mask = Set_HashGroup(small, group_index, &result, hash);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+            if (!Set_InsertHashed(&result, Set_KeyAt(small, group_index, bitpos), hash[bitpos])) {
+                Set_Uninit(&result);
+                return false;
+            }
+        }
+    }
+
+    Set_Uninit(dst);
+    *dst = result;
+    return true;
+}
+
+/**
+ * @brief Computes the intersection of two sets, every key in both of them
+ * @param dst The set to store the intersection in, its contents are replaced, it may be @param set_a or @param set_b
+ * @param set_a, set_b The sets to intersect
+ * @return True if the intersection was stored, false if an allocation failed (@param dst is left untouched)
+ * @note Probes the larger set for each of the smaller set's keys, the result is sized for the smaller set up front
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Intersect(Set(Tkey_) * dst, Set(Tkey_) * set_a, Set(Tkey_) * set_b) {
+    Set(Tkey_)* small = set_a->size <= set_b->size ? set_a : set_b;
+    Set(Tkey_)* large = set_a->size <= set_b->size ? set_b : set_a;
+
+    // seeded like the larger set, a key's hash for probing it is then also its hash in the result
+    Set(Tkey_) result;
+    if (!Set_InitWithSeed(&result, Set_CapacityFor(small, small->size) - 1, large->seed)) {
+        return false;
+    }
+
+    const size_t max_group_index = small->capacity / 16;
+    for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+        uint64_t hash[16];
+        uint16_t occupied_mask = Set_HashGroup(small, group_index, large, hash);
+
+        for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+            bitpos = ffs(imask) - 1;
+
+            size_t found_group, found_slot;
+            Tkey   key = Set_KeyAt(small, group_index, bitpos);
+            if (Set_Find(large, key, hash[bitpos], &found_group, &found_slot)) {
+                // the keys of a set are unique, there's nothing to compare and the result can't need to grow
+                Set_PlaceKey(&result, key, hash[bitpos]);
+                result.size += 1;
+            }
+        }
+    }
+
+    Set_Uninit(dst);
+    *dst = result;
+    return true;
+}
+
+/**
+ * @brief Computes the difference of two sets, every key in @param set_a that isn't in @param set_b
+ * @param dst The set to store the difference in, its contents are replaced, it may be @param set_a or @param set_b
+ * @param set_a The set to take keys from
+ * @param set_b The set of keys to leave out
+ * @return True if the difference was stored, false if an allocation failed (@param dst is left untouched)
+ * @note If @param set_a is the smaller set its keys are probed for in @param set_b, otherwise @param set_a's table
+ * is copied and @param set_b's keys are probed for and removed from the copy
+ */
+CTL_OVERLOADABLE
+static inline bool Set_Difference(Set(Tkey_) * dst, Set(Tkey_) * set_a, Set(Tkey_) * set_b) {
+    Set(Tkey_) result = {.metadata_group = NULL};
+
+    if (set_a->size <= set_b->size) {
+        if (!Set_InitWithSeed(&result, Set_CapacityFor(set_a, set_a->size) - 1, set_b->seed)) {
+            return false;
+        }
+
+        const size_t max_group_index = set_a->capacity / 16;
+        for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+            uint64_t hash[16];
+            uint16_t occupied_mask = Set_HashGroup(set_a, group_index, set_b, hash);
+
+            for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+                bitpos = ffs(imask) - 1;
+
+                size_t found_group, found_slot;
+                Tkey   key = Set_KeyAt(set_a, group_index, bitpos);
+                if (!Set_Find(set_b, key, hash[bitpos], &found_group, &found_slot)) {
+                    Set_PlaceKey(&result, key, hash[bitpos]);
+                    result.size += 1;
+                }
+            }
+        }
+    } else {
+        if (!Set_Copy(set_a, &result)) {
+            return false;
+        }
+
+        const size_t max_group_index = set_b->capacity / 16;
+        for (size_t group_index = 0; group_index < max_group_index; group_index++) {
+            uint64_t hash[16];
+            uint16_t occupied_mask = Set_HashGroup(set_b, group_index, &result, hash);
+
+            for (int imask = occupied_mask, bitpos = 0; imask != 0; imask &= ~(1 << bitpos)) {
+                bitpos = ffs(imask) - 1;
+
+                size_t found_group, found_slot;
+                Tkey   key = Set_KeyAt(set_b, group_index, bitpos);
+                if (Set_Find(&result, key, hash[bitpos], &found_group, &found_slot)) {
+                    Set_RemoveSlot(&result, found_group, found_slot);
+                }
+            }
+        }
+    }
+
+    Set_Uninit(dst);
+    *dst = result;
+    return true;
+}
+
+// cleanup macros
+#undef Set_KeyType
+#undef Set_KeyType_Alias
+
+#undef Set_CompareKey
+#undef Set_CompareKey_Default
+#undef Set_MatchKeys
+#undef Set_HashKey
+#undef Set_HashKeySeeded
+#undef Set_MixHash
+#undef Set_MaxLoad
+
+#undef Set_Malloc
+#undef Set_Free
+#undef CTL_SET_DEFAULT_ALLOC
+
+#undef Set_KeyAt
+
+#undef Tkey
+#undef Tkey_
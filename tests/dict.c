@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #define Dict_KeyType         int
 #define Dict_ValueType       char*
@@ -12,6 +13,13 @@
 #define Dict_KeyType       char*
 #define Dict_KeyType_Alias str
 #define Dict_ValueType     int
+#define Dict_LookupType    Dict_StrView
+#define Dict_CacheHash
+#include "containers/dict.h"
+
+#define Dict_KeyType       Dict_StrView
+#define Dict_KeyType_Alias strview
+#define Dict_ValueType     int
 #include "containers/dict.h"
 
 typedef struct {
@@ -22,13 +30,39 @@ typedef struct {
 #define Dict_ValueType          float
 #define Dict_HashKey(key)       (key.x + key.y)
 #define Dict_CompareKey(k1, k2) (k1.x == k2.x && k1.y == k2.y)
+#define Dict_Stats
+#include "containers/dict.h"
+
+#define Dict_KeyType           long
+#define Dict_ValueType         int
+#define Dict_MaxLoad(capacity) ((capacity) / 2)
+#include "containers/dict.h"
+
+// an identity hash, the high bits that pick the group are zero for small keys
+#define Dict_KeyType       int64_t
+#define Dict_KeyType_Alias id
+#define Dict_ValueType     int
+#define Dict_HashKey(key)  ((uint64_t)(key))
+#define Dict_Stats
+#include "containers/dict.h"
+
+// defined empty, migrates one group per operation
+#define Dict_KeyType   uint32_t
+#define Dict_ValueType int
+#define Dict_Incremental
+#include "containers/dict.h"
+
+#define Dict_KeyType     uint64_t
+#define Dict_ValueType   int
+#define Dict_GrowInPlace
+#define Dict_Mappable
 #include "containers/dict.h"
 
 bool enable_allocations = true;
 
 void* Special_Malloc(size_t bytes) {
     if (enable_allocations) {
-        return malloc(bytes);
+        return calloc(1, bytes);
     } else {
         return NULL;
     }
@@ -54,6 +88,57 @@ void Special_Free(void* ptr) {
 #define Dict_Free      Special_Free
 #include "containers/dict.h"
 
+size_t counted_allocations = 0;
+
+void* Counting_Malloc(size_t bytes) {
+    counted_allocations += 1;
+    return calloc(1, bytes);
+}
+
+#define Dict_KeyType   uint16_t
+#define Dict_ValueType int
+#define Dict_Inline
+#define Dict_Malloc  Counting_Malloc
+#define Dict_Realloc realloc
+#define Dict_Free    free
+#include "containers/dict.h"
+
+#define Dict_KeyType   uint8_t
+#define Dict_ValueType double
+#define Dict_Layout    Dict_Layout_Interleaved
+#define Dict_Mappable
+#include "containers/dict.h"
+
+#define Dict_KeyType   int
+#define Dict_ValueType int
+#define Dict_Layout    Dict_Layout_Ordered
+#include "containers/dict.h"
+
+#define Dict_KeyType   int8_t
+#define Dict_ValueType int
+#include "containers/dict.h"
+
+#define Dict_KeyType   int32_t
+#define Dict_ValueType int
+#define Dict_SimdKeys
+#include "containers/dict.h"
+
+bool is_multiple_of_3(int* key, float* val, void* ctx) {
+    (void)val;
+    (void)ctx;
+    return *key % 3 == 0;
+}
+
+void add_ints(int* dst_val, int* src_val, void* ctx) {
+    *dst_val += *src_val;
+    *(int*)ctx += 1;
+}
+
+void add_floats(float* dst_val, float* src_val, void* ctx) {
+    (void)ctx;
+    *dst_val += *src_val;
+}
+
 int main(void) {
     /* -- Test A, Basic Get/Set usage --- */
     Dict(int, str)* dict_a = Dict_New(int, str)(0);
@@ -92,6 +177,16 @@ int main(void) {
         assert(out_val_b == ii);
     }
 
+    // lookups through a view into a buffer that isn't NUL terminated
+    const char* buffer = "40954095";
+    int         out_val_view;
+    assert(Dict_Get(&dict_b, (Dict_StrView){buffer, 4}, &out_val_view));
+    assert(out_val_view == 4095);
+    assert(Dict_Get(&dict_b, (Dict_StrView){buffer + 2, 2}, &out_val_view));
+    assert(out_val_view == 95);
+    assert(!Dict_Get(&dict_b, (Dict_StrView){buffer, 8}, &out_val_view));
+    assert(!Dict_Get(&dict_b, (Dict_StrView){buffer, 0}, &out_val_view));
+
     /* --- Test C, Weirder usage --- */
     Dict(str, int)* dict_c = Dict_New(str, int)(0);
     assert(dict_c != NULL);
@@ -116,6 +211,716 @@ int main(void) {
         assert(out_val_b == ii);
     }
 
+    /* --- Test D, Remove/RemoveIf --- */
+    Dict(int, float) dict_d;
+    assert(Dict_Init(&dict_d, 0));
+
+    for (int ii = 0; ii < 4096; ii++) {
+        assert(Dict_Set(&dict_d, ii, (float)ii));
+    }
+
+    for (int ii = 0; ii < 4096; ii += 2) {
+        assert(Dict_Remove(&dict_d, ii));
+    }
+
+    assert(!Dict_Remove(&dict_d, 0));
+    assert(dict_d.size == 2048);
+
+    for (int ii = 0; ii < 4096; ii++) {
+        float out_val_d;
+        assert(Dict_Get(&dict_d, ii, &out_val_d) == (ii % 2 == 1));
+    }
+
+    assert(Dict_RemoveIf(&dict_d, is_multiple_of_3, NULL) == 683);
+
+    for (int ii = 0; ii < 4096; ii++) {
+        float out_val_d;
+        assert(Dict_Get(&dict_d, ii, &out_val_d) == (ii % 2 == 1 && ii % 3 != 0));
+    }
+
+    // steady state churn shouldn't grow the dict
+    size_t churn_capacity = dict_d.capacity;
+    for (int ii = 4096; ii < 4096 * 64; ii++) {
+        assert(Dict_Set(&dict_d, ii, (float)ii));
+        assert(Dict_Remove(&dict_d, ii));
+    }
+
+    assert(dict_d.capacity == churn_capacity);
+    assert(dict_d.size == 1365);
+
+    Dict_Uninit(&dict_d);
+
+    /* --- Test E, String view keys --- */
+    Dict(strview, int) dict_e;
+    assert(Dict_Init(&dict_e, 0));
+
+    const char* words = "alpha beta gamma delta alpha beta";
+    for (size_t start = 0, end = 0; words[start] != '\0'; start = end + (words[end] != '\0')) {
+        for (end = start; words[end] != ' ' && words[end] != '\0'; end++) {
+        }
+
+        Dict_StrView word  = {words + start, end - start};
+        int          count = 0;
+        Dict_Get(&dict_e, word, &count);
+        assert(Dict_Set(&dict_e, word, count + 1));
+    }
+
+    int out_val_e;
+    assert(dict_e.size == 4);
+    assert(Dict_Get(&dict_e, (Dict_StrView){"alpha", 5}, &out_val_e) && out_val_e == 2);
+    assert(Dict_Get(&dict_e, (Dict_StrView){"gamma", 5}, &out_val_e) && out_val_e == 1);
+    assert(!Dict_Get(&dict_e, (Dict_StrView){"alph", 4}, &out_val_e));
+
+    // a view with a NUL in it isn't equal to the string before the NUL, nor is one longer than the string
+    assert(Dict_CompareKey_StrViewStr((Dict_StrView){"alpha", 5}, "alpha"));
+    assert(!Dict_CompareKey_StrViewStr((Dict_StrView){"al\0ha", 5}, "al"));
+    assert(!Dict_CompareKey_StrViewStr((Dict_StrView){"alphas", 6}, "alpha"));
+
+    Dict_Uninit(&dict_e);
+
+    /* --- Test F, Batched Get/Set --- */
+    Dict(int, float) dict_f;
+    assert(Dict_Init(&dict_f, 0));
+
+    int   keys_f[100], miss_keys_f[100];
+    float vals_f[100], out_vals_f[100];
+    bool  found_f[100];
+    for (int ii = 0; ii < 100; ii++) {
+        keys_f[ii]      = ii * 7;
+        miss_keys_f[ii] = ii % 2 ? ii * 7 : -ii - 1;
+        vals_f[ii]      = (float)ii;
+    }
+
+    assert(Dict_SetMany(&dict_f, keys_f, vals_f, 100));
+    assert(dict_f.size == 100);
+    assert(Dict_GetMany(&dict_f, keys_f, 100, out_vals_f, NULL) == 100);
+    assert(memcmp(vals_f, out_vals_f, sizeof(vals_f)) == 0);
+
+    assert(Dict_GetMany(&dict_f, miss_keys_f, 100, out_vals_f, found_f) == 50);
+    for (int ii = 0; ii < 100; ii++) {
+        assert(found_f[ii] == (ii % 2 == 1));
+    }
+
+    assert(Dict_Reserve(&dict_f, 10000));
+    size_t reserved_capacity = dict_f.capacity;
+    for (int ii = 0; ii < 10000; ii++) {
+        assert(Dict_Set(&dict_f, ii, (float)ii));
+    }
+
+    assert(dict_f.capacity == reserved_capacity);
+
+    Dict_Uninit(&dict_f);
+
+    /* --- Test G, Max load --- */
+    Dict(int, float) dict_g_default;
+    Dict(long, int) dict_g_half;
+    assert(Dict_Init(&dict_g_default, 0));
+    assert(Dict_Init(&dict_g_half, 0));
+
+    for (int ii = 0; ii < 10000; ii++) {
+        assert(Dict_Set(&dict_g_default, ii, (float)ii));
+        assert(Dict_Set(&dict_g_half, (long)ii, ii));
+    }
+
+    assert(dict_g_default.capacity == 16384);
+    assert(dict_g_half.capacity == 32768);
+
+    // 7/8ths of 16384 still fits without growing
+    assert(Dict_Reserve(&dict_g_default, 14336));
+    assert(dict_g_default.capacity == 16384);
+    assert(Dict_Reserve(&dict_g_default, 14337));
+    assert(dict_g_default.capacity == 32768);
+
+    for (int ii = 0; ii < 10000; ii++) {
+        int out_val_g;
+        assert(Dict_Get(&dict_g_half, (long)ii, &out_val_g) && out_val_g == ii);
+    }
+
+    Dict_Uninit(&dict_g_default);
+    Dict_Uninit(&dict_g_half);
+
+    /* --- Test H, Incremental growth --- */
+    Dict(uint32_t, int) dict_h;
+    assert(Dict_Init(&dict_h, 0));
+
+    uint32_t inserted_h = 0;
+    while (dict_h.old_capacity == 0) {
+        assert(Dict_Set(&dict_h, inserted_h, (int)inserted_h));
+        inserted_h += 1;
+    }
+
+    // the grow only allocated, everything is still in the old table
+    assert(dict_h.capacity == 2 * dict_h.old_capacity);
+    assert(dict_h.old_size == inserted_h);
+    assert(Dict_Remove(&dict_h, 0));
+    assert(!Dict_Remove(&dict_h, 0));
+
+    while (dict_h.old_capacity != 0) {
+        assert(Dict_Set(&dict_h, inserted_h, (int)inserted_h));
+        inserted_h += 1;
+    }
+
+    assert(dict_h.size == inserted_h - 1);
+    for (uint32_t ii = 0; ii < inserted_h; ii++) {
+        int out_val_h;
+        assert(Dict_Get(&dict_h, ii, &out_val_h) == (ii != 0));
+    }
+
+    Dict_Uninit(&dict_h);
+
+    /* --- Test I, In-place growth --- */
+    Dict(uint64_t, int) dict_i;
+    assert(Dict_Init(&dict_i, 0));
+
+    for (uint64_t ii = 0; ii < 100000; ii++) {
+        assert(Dict_Set(&dict_i, ii * 0x10001, (int)ii));
+    }
+
+    assert(dict_i.size == 100000 && dict_i.tombstones == 0);
+    for (uint64_t ii = 0; ii < 100000; ii++) {
+        int out_val_i;
+        assert(Dict_Get(&dict_i, ii * 0x10001, &out_val_i) && out_val_i == (int)ii);
+    }
+
+    Dict_Uninit(&dict_i);
+
+    /* --- Test J, Iteration --- */
+    Dict(int, str) dict_j;
+    assert(Dict_Init(&dict_j, 0));
+
+    char* names_j[] = {"zero", "one", "two", "three", "four"};
+    for (int ii = 0; ii < 1000; ii++) {
+        assert(Dict_Set(&dict_j, ii, names_j[ii % 5]));
+    }
+
+    long key_sum_j = 0, visited_j = 0;
+    Dict_ForEach(&dict_j, key, val) {
+        assert(*val == names_j[*key % 5]);
+        key_sum_j += *key;
+        visited_j += 1;
+    }
+
+    assert(visited_j == 1000 && key_sum_j == 999 * 1000 / 2);
+
+    visited_j = 0;
+    Dict_ForEach(&dict_j, key, val) {
+        (void)key;
+        (void)val;
+        if (++visited_j == 10) {
+            break;
+        }
+    }
+
+    assert(visited_j == 10);
+
+    // the loop variables can have any names, not just the iterator's member names
+    key_sum_j = 0;
+    Dict_ForEach(&dict_j, k, v) {
+        assert(*v == names_j[*k % 5]);
+        key_sum_j += *k;
+    }
+
+    assert(key_sum_j == 999 * 1000 / 2);
+
+    // values and keys are different sizes here, enumerating values must still visit each one once
+    visited_j = 0;
+    for (char** val = Dict_EnumerateValues(&dict_j, NULL); val != NULL; val = Dict_EnumerateValues(&dict_j, val)) {
+        visited_j += 1;
+    }
+
+    assert(visited_j == 1000);
+
+    Dict_Uninit(&dict_j);
+
+    /* --- Test K, GetPtr/Upsert --- */
+    Dict(int, float) dict_k;
+    assert(Dict_Init(&dict_k, 0));
+
+    for (int ii = 0; ii < 5000; ii++) {
+        bool   inserted_k;
+        float* val_k = Dict_Upsert(&dict_k, ii % 1000, &inserted_k);
+        assert(val_k != NULL && inserted_k == (ii < 1000));
+        *val_k += 1.0f;
+    }
+
+    assert(dict_k.size == 1000);
+    for (int ii = 0; ii < 1000; ii++) {
+        float* val_k = Dict_GetPtr(&dict_k, ii);
+        assert(val_k != NULL && *val_k == 5.0f);
+    }
+
+    assert(Dict_GetPtr(&dict_k, 1000) == NULL);
+
+    // growth inside Upsert must hand back a pointer into the new table
+    for (int ii = 1000; ii < 100000; ii++) {
+        *Dict_Upsert(&dict_k, ii, NULL) = (float)ii;
+    }
+
+    for (int ii = 1000; ii < 100000; ii++) {
+        assert(*Dict_GetPtr(&dict_k, ii) == (float)ii);
+    }
+
+    Dict_Uninit(&dict_k);
+
+    /* --- Test L, Inline storage --- */
+    Dict(uint16_t, int) dict_l, dict_l_copy;
+    assert(Dict_Init(&dict_l, 0));
+    assert(Dict_Init(&dict_l_copy, 0));
+
+    for (uint16_t ii = 0; ii < 14; ii++) {
+        assert(Dict_Set(&dict_l, ii, ii * 2));
+    }
+
+    assert(Dict_Remove(&dict_l, 3));
+    assert(Dict_Copy(&dict_l, &dict_l_copy));
+    assert(counted_allocations == 0);
+
+    // the copy has its own inline group
+    assert(Dict_Set(&dict_l_copy, 3, 6));
+    assert(!Dict_Get(&dict_l, 3, &(int){0}));
+
+    // spilling to the heap
+    for (uint16_t ii = 14; ii < 100; ii++) {
+        assert(Dict_Set(&dict_l_copy, ii, ii * 2));
+    }
+
+    assert(counted_allocations > 0);
+    for (uint16_t ii = 0; ii < 100; ii++) {
+        int out_val_l;
+        assert(Dict_Get(&dict_l_copy, ii, &out_val_l) && out_val_l == ii * 2);
+    }
+
+    Dict_Uninit(&dict_l);
+    Dict_Uninit(&dict_l_copy);
+
+    /* --- Test M, Interleaved layout --- */
+    Dict(uint8_t, double) dict_m, dict_m_copy;
+    assert(Dict_Init(&dict_m, 0));
+    assert(Dict_Init(&dict_m_copy, 0));
+
+    for (int ii = 0; ii < 256; ii++) {
+        assert(Dict_Set(&dict_m, (uint8_t)ii, ii * 0.5));
+    }
+
+    for (int ii = 0; ii < 256; ii += 2) {
+        assert(Dict_Remove(&dict_m, (uint8_t)ii));
+    }
+
+    assert(Dict_Copy(&dict_m, &dict_m_copy));
+    for (int ii = 0; ii < 256; ii++) {
+        double out_val_m;
+        assert(Dict_Get(&dict_m_copy, (uint8_t)ii, &out_val_m) == (ii % 2 == 1));
+        assert(ii % 2 == 0 || out_val_m == ii * 0.5);
+    }
+
+    // keys and values share a stride here, enumerating either must visit each entry once
+    long visited_m = 0;
+    for (uint8_t* key = Dict_EnumerateKeys(&dict_m, NULL); key != NULL; key = Dict_EnumerateKeys(&dict_m, key)) {
+        assert(*key % 2 == 1);
+        visited_m += 1;
+    }
+
+    for (double* val = Dict_EnumerateValues(&dict_m, NULL); val != NULL; val = Dict_EnumerateValues(&dict_m, val)) {
+        visited_m += 1;
+    }
+
+    assert(visited_m == 256);
+
+    Dict_Uninit(&dict_m);
+    Dict_Uninit(&dict_m_copy);
+
+    /* --- Test N, Stats --- */
+    Dict(foo, float) dict_n;
+    assert(Dict_Init(&dict_n, 0));
+
+    for (int ii = 0; ii < 32; ii++) {
+        for (int jj = 0; jj < 32; jj++) {
+            assert(Dict_Set(&dict_n, (foo){ii, jj}, (float)(ii * jj)));
+        }
+    }
+
+    assert(dict_n.stats.misses == 1024 && dict_n.stats.hits == 0);
+    assert(dict_n.stats.grows == 7);
+
+    Dict_ResetStats(&dict_n);
+    for (int ii = 0; ii < 32; ii++) {
+        for (int jj = 0; jj < 32; jj++) {
+            float out_val_n;
+            assert(Dict_Get(&dict_n, (foo){ii, jj}, &out_val_n) && out_val_n == (float)(ii * jj));
+        }
+    }
+
+    // x + y only has 63 distinct values here, keys with the same sum share a tag and probe sequence
+    assert(dict_n.stats.hits == 1024 && dict_n.stats.misses == 0);
+    assert(dict_n.stats.tag_matches == dict_n.stats.compares);
+    assert(dict_n.stats.tag_matches > 10 * dict_n.stats.hits);
+    assert(dict_n.stats.hit_histogram[0] < dict_n.stats.hits);
+
+    // a custom 64-bit hash is mixed before it picks a group, sequential keys don't all start probing at group 0
+    Dict(id, int) dict_n_id;
+    assert(Dict_Init(&dict_n_id, 0));
+    for (int ii = 0; ii < 32768; ii++) {
+        assert(Dict_Set(&dict_n_id, ii, ii));
+    }
+
+    Dict_ResetStats(&dict_n_id);
+    for (int ii = 0; ii < 32768; ii++) {
+        int out_val_n;
+        assert(Dict_Get(&dict_n_id, ii, &out_val_n) && out_val_n == ii);
+    }
+    assert(dict_n_id.stats.hit_groups < 2 * dict_n_id.stats.hits);
+
+    Dict_Uninit(&dict_n);
+    Dict_Uninit(&dict_n_id);
+
+    /* --- Test O, Hash seeds --- */
+    Dict(int, str) dict_o, dict_o_seeded, dict_o_copy;
+    assert(Dict_Init(&dict_o, 0));
+    assert(Dict_InitWithSeed(&dict_o_seeded, 0, 1234));
+    assert(Dict_Init(&dict_o_copy, 0));
+
+    assert(dict_o_seeded.seed == 1234);
+    assert(Dict_Hash(&dict_o, 42) != Dict_Hash(&dict_o_seeded, 42));
+
+    for (int ii = 0; ii < 1000; ii++) {
+        assert(Dict_Set(&dict_o_seeded, ii, "seeded"));
+    }
+
+    // the copy's entries sit where the source's seed put them
+    assert(Dict_Copy(&dict_o_seeded, &dict_o_copy));
+    assert(dict_o_copy.seed == 1234);
+    for (int ii = 0; ii < 1000; ii++) {
+        char* out_val_o;
+        assert(Dict_Get(&dict_o_copy, ii, &out_val_o) && !strcmp(out_val_o, "seeded"));
+    }
+
+    Dict_Uninit(&dict_o);
+    Dict_Uninit(&dict_o_seeded);
+    Dict_Uninit(&dict_o_copy);
+
+    /* --- Test P, Saving and mapping --- */
+    Dict(uint64_t, int) dict_p, dict_p_mapped, dict_p_copy;
+    Dict(uint8_t, double) dict_p_wrong;
+    char path_p[] = "/tmp/ctl_dict_test_XXXXXX";
+    close(mkstemp(path_p));
+
+    assert(Dict_Init(&dict_p, 0));
+    for (uint64_t ii = 0; ii < 5000; ii++) {
+        assert(Dict_Set(&dict_p, ii * 7, (int)ii));
+    }
+
+    assert(Dict_Remove(&dict_p, 7));
+    assert(Dict_Save(&dict_p, path_p));
+
+    assert(Dict_MapFile(&dict_p_mapped, path_p));
+    assert(dict_p_mapped.size == 4999 && dict_p_mapped.seed == dict_p.seed);
+    for (uint64_t ii = 0; ii < 5000; ii++) {
+        int out_val_p;
+        assert(Dict_Get(&dict_p_mapped, ii * 7, &out_val_p) == (ii != 1));
+        assert(ii == 1 || out_val_p == (int)ii);
+    }
+
+    // a writable copy of the mapped dict
+    assert(Dict_Init(&dict_p_copy, 0));
+    assert(Dict_Copy(&dict_p_mapped, &dict_p_copy));
+    assert(Dict_Set(&dict_p_copy, 7, 1));
+    assert(dict_p_copy.size == 5000);
+
+    // a file saved by another instantiation is rejected
+    assert(!Dict_MapFile(&dict_p_wrong, path_p));
+
+    Dict_Uninit(&dict_p);
+    Dict_Uninit(&dict_p_mapped);
+    Dict_Uninit(&dict_p_copy);
+    remove(path_p);
+
+    /* --- Test Q, Frozen dicts --- */
+    Dict(int, float) dict_q;
+    Dict_Frozen(int, float) frozen_q;
+    assert(Dict_Init(&dict_q, 0));
+
+    assert(Dict_Freeze(&dict_q, &frozen_q));
+    assert(Dict_GetPtr(&frozen_q, 0) == NULL);
+    Dict_Uninit(&frozen_q);
+
+    for (int ii = 0; ii < 10000; ii++) {
+        assert(Dict_Set(&dict_q, ii * 3, (float)ii));
+    }
+
+    assert(Dict_Freeze(&dict_q, &frozen_q));
+    assert(frozen_q.size == 10000);
+    for (int ii = 0; ii < 30000; ii++) {
+        float out_val_q;
+        assert(Dict_Get(&frozen_q, ii, &out_val_q) == (ii % 3 == 0));
+        assert(ii % 3 != 0 || out_val_q == (float)(ii / 3));
+    }
+
+    Dict_Uninit(&dict_q);
+    Dict_Uninit(&frozen_q);
+
+    // with x + y as the hash these two keys have the same full hash, no displacement can separate them
+    Dict(foo, float) dict_q_collide;
+    Dict_Frozen(foo, float) frozen_q_collide;
+    assert(Dict_Init(&dict_q_collide, 0));
+    assert(Dict_Set(&dict_q_collide, (foo){1, 2}, 1.0f));
+    assert(Dict_Set(&dict_q_collide, (foo){2, 1}, 2.0f));
+    assert(!Dict_Freeze(&dict_q_collide, &frozen_q_collide));
+    Dict_Uninit(&dict_q_collide);
+
+    /* --- Test R, Ordered layout --- */
+    Dict(int, int) dict_r, dict_r_copy;
+    assert(Dict_Init(&dict_r, 0));
+    assert(Dict_Init(&dict_r_copy, 0));
+
+    for (int ii = 0; ii < 1000; ii++) {
+        assert(Dict_Set(&dict_r, ii, ii * 2));
+    }
+
+    for (int ii = 0; ii < 1000; ii += 3) {
+        assert(Dict_Remove(&dict_r, ii));
+    }
+
+    // overwriting keeps an entry's place, removing and adding it again moves it to the end
+    assert(Dict_Set(&dict_r, 1, -1));
+    assert(Dict_Set(&dict_r, 0, 0));
+    assert(Dict_Copy(&dict_r, &dict_r_copy));
+
+    int next_r = 1;
+    Dict_ForEach(&dict_r_copy, key, val) {
+        if (next_r == 1000) {
+            assert(*key == 0 && *val == 0);
+        } else {
+            assert(*key == next_r && *val == (next_r == 1 ? -1 : next_r * 2));
+        }
+
+        next_r += next_r % 3 == 2 ? 2 : 1;
+        next_r = next_r > 1000 ? 1000 : next_r;
+    }
+
+    assert(next_r == 1000);
+
+    // churn at a steady size, the holes get compacted away without the table growing
+    size_t capacity_r = dict_r.capacity;
+    for (int ii = 1000; ii < 100000; ii++) {
+        assert(Dict_Set(&dict_r, ii, ii * 2));
+        Dict_Remove(&dict_r, ii - 400);
+    }
+
+    assert(dict_r.capacity == capacity_r);
+
+    size_t visited_r = 0;
+    int    prev_r    = 0;
+    for (int* key = Dict_EnumerateKeys(&dict_r, NULL); key != NULL; key = Dict_EnumerateKeys(&dict_r, key)) {
+        int out_val_r;
+        assert(*key < 1000 || *key > prev_r);
+        assert(Dict_Get(&dict_r, *key, &out_val_r) && out_val_r == (*key == 1 ? -1 : *key * 2));
+        prev_r = *key;
+        visited_r += 1;
+    }
+
+    assert(visited_r == dict_r.size && prev_r == 99999);
+
+    // adding new keys and removing them newest first never leaves a hole in the entry array, but the tombstones
+    // they leave in the index still count against the max load, or the index would fill up without growing
+    Dict(int, int) dict_r_lifo;
+    assert(Dict_Init(&dict_r_lifo, 0));
+    for (int ii = 0; ii < 1500; ii++) {
+        assert(Dict_Set(&dict_r_lifo, ii, ii));
+    }
+
+    for (int ii = 1500; ii < 1500 + 20 * 2048; ii += 290) {
+        for (int jj = ii; jj < ii + 290; jj++) {
+            assert(Dict_Set(&dict_r_lifo, jj, jj));
+        }
+        for (int jj = ii + 290; jj-- > ii;) {
+            assert(Dict_Remove(&dict_r_lifo, jj));
+        }
+        assert(dict_r_lifo.size + dict_r_lifo.tombstones <= dict_r_lifo.capacity - dict_r_lifo.capacity / 8);
+    }
+
+    for (int ii = 0; ii < 3000; ii++) {
+        int out_val_r;
+        assert(Dict_Get(&dict_r_lifo, ii, &out_val_r) == (ii < 1500));
+    }
+
+    Dict_Uninit(&dict_r);
+    Dict_Uninit(&dict_r_lifo);
+    Dict_Uninit(&dict_r_copy);
+
+    /* --- Test S, Integer keys matched with SIMD --- */
+    Dict(int8_t, int) dict_s8;
+    Dict(int32_t, int) dict_s32;
+    assert(Dict_Init(&dict_s8, 0));
+    assert(Dict_Init(&dict_s32, 0));
+
+    // every 8-bit key, then remove the odd ones, a removed key's slot keeps its stale copy of the key
+    for (int ii = -128; ii < 128; ii++) {
+        assert(Dict_Set(&dict_s8, (int8_t)ii, ii));
+    }
+
+    for (int ii = -127; ii < 128; ii += 2) {
+        assert(Dict_Remove(&dict_s8, (int8_t)ii));
+    }
+
+    assert(dict_s8.size == 128);
+    for (int ii = -128; ii < 128; ii++) {
+        int out_val_s;
+        assert(Dict_Get(&dict_s8, (int8_t)ii, &out_val_s) == (ii % 2 == 0));
+        assert(ii % 2 != 0 || out_val_s == ii);
+    }
+
+    // keys that only differ in their upper bytes or sign
+    for (int ii = 1; ii < 5000; ii++) {
+        assert(Dict_Set(&dict_s32, ii, ii));
+        assert(Dict_Set(&dict_s32, ii << 16, -ii));
+        assert(Dict_Set(&dict_s32, -ii - 1, ii * 2));
+    }
+
+    for (int ii = 2; ii < 5000; ii += 2) {
+        assert(Dict_Remove(&dict_s32, ii << 16));
+    }
+
+    assert(dict_s32.size == 4999 * 3 - 2499);
+    for (int ii = 1; ii < 5000; ii++) {
+        int out_val_s;
+        assert(Dict_Get(&dict_s32, ii, &out_val_s) && out_val_s == ii);
+        assert(Dict_Get(&dict_s32, -ii - 1, &out_val_s) && out_val_s == ii * 2);
+        assert(Dict_Get(&dict_s32, ii << 16, &out_val_s) == (ii % 2 != 0));
+        assert(ii % 2 == 0 || out_val_s == -ii);
+    }
+
+    Dict_Uninit(&dict_s8);
+    Dict_Uninit(&dict_s32);
+
+    /* --- Test T, Sharded dicts --- */
+    Dict_Sharded(int, str) dict_t;
+    assert(Dict_InitSharded(&dict_t, 0, 6));
+    assert(dict_t.shard_count == 8);
+
+    for (int ii = 0; ii < 20000; ii++) {
+        assert(Dict_Set(&dict_t, ii, ii % 2 ? "odd" : "even"));
+    }
+
+    for (int ii = 0; ii < 20000; ii += 4) {
+        assert(Dict_Remove(&dict_t, ii));
+    }
+
+    assert(!Dict_Remove(&dict_t, 0));
+    assert(Dict_Size(&dict_t) == 15000);
+
+    // every shard got a share of the keys and grew on its own
+    for (size_t ii = 0; ii < dict_t.shard_count; ii++) {
+        assert(dict_t.shard[ii].dict.size > 1000 && dict_t.shard[ii].dict.capacity >= 2048);
+    }
+
+    for (int ii = 0; ii < 20000; ii++) {
+        char* out_val_t;
+        assert(Dict_Get(&dict_t, ii, &out_val_t) == (ii % 4 != 0));
+        assert(ii % 4 == 0 || strcmp(out_val_t, ii % 2 ? "odd" : "even") == 0);
+    }
+
+    Dict_Uninit(&dict_t);
+
+    /* --- Test U, Read-copy-update dicts --- */
+    Dict_Rcu(uint32_t, int) dict_u;
+    assert(Dict_InitRcu(&dict_u, 0, 2));
+
+    for (uint32_t ii = 0; ii < 100; ii++) {
+        assert(Dict_Set(&dict_u, ii, (int)ii));
+    }
+
+    assert(Dict_Remove(&dict_u, 7));
+    assert(!Dict_Remove(&dict_u, 7));
+
+    // a read keeps seeing the table it started with, a write publishes a new one in its place
+    Dict(uint32_t, int)* snapshot_u = Dict_ReadBegin(&dict_u, 1);
+    Dict(uint32_t, int)* write_u    = Dict_WriteBegin(&dict_u);
+    assert(write_u != NULL && write_u != snapshot_u);
+
+    for (uint32_t ii = 100; ii < 5000; ii++) {
+        assert(Dict_Set(write_u, ii, (int)ii * 2));
+    }
+
+    assert(snapshot_u->size == 99 && write_u->size == 4999);
+    Dict_ReadEnd(&dict_u, 1);
+    Dict_Publish(&dict_u, write_u);
+
+    for (uint32_t ii = 0; ii < 5000; ii++) {
+        int out_val_u;
+        assert(Dict_Get(&dict_u, 0, ii, &out_val_u) == (ii != 7));
+        assert(ii == 7 || out_val_u == (int)(ii < 100 ? ii : ii * 2));
+    }
+
+    Dict_Uninit(&dict_u);
+
+    /* --- Test V, Merging and partitioned aggregation --- */
+    Dict(int, int) dict_v_dst, dict_v_src;
+    assert(Dict_Init(&dict_v_dst, 0));
+    assert(Dict_Init(&dict_v_src, 0));
+
+    for (int ii = 0; ii < 3000; ii++) {
+        assert(Dict_Set(ii < 2000 ? &dict_v_dst : &dict_v_src, ii, ii));
+        assert(ii < 1000 || ii >= 2000 || Dict_Set(&dict_v_src, ii, 1));
+    }
+
+    // keys only in src_dict keep their order, appended after dst_dict's
+    int combined_v = 0;
+    assert(Dict_Merge(&dict_v_dst, &dict_v_src, add_ints, &combined_v));
+    assert(combined_v == 1000 && dict_v_dst.size == 3000 && dict_v_src.size == 2000);
+
+    int next_v = 0;
+    Dict_ForEach(&dict_v_dst, key, val) {
+        assert(*key == next_v && *val == (next_v >= 1000 && next_v < 2000 ? next_v + 1 : next_v));
+        next_v += 1;
+    }
+
+    Dict_Uninit(&dict_v_dst);
+    Dict_Uninit(&dict_v_src);
+
+    // the identity hash ignores the seed, dicts seeded differently still agree on every key's hash
+    Dict(id, int) dict_v_id_dst, dict_v_id_src;
+    assert(Dict_InitWithSeed(&dict_v_id_dst, 0, 1) && Dict_InitWithSeed(&dict_v_id_src, 0, 2));
+    for (int ii = 0; ii < 1000; ii++) {
+        assert(Dict_Set(&dict_v_id_dst, ii, ii) && Dict_Set(&dict_v_id_src, ii + 500, -ii));
+    }
+
+    assert(Dict_Merge(&dict_v_id_dst, &dict_v_id_src, NULL, NULL));
+    assert(dict_v_id_dst.size == 1500);
+    for (int ii = 0; ii < 1500; ii++) {
+        int out_val_v;
+        assert(Dict_Get(&dict_v_id_dst, ii, &out_val_v) && out_val_v == (ii < 500 ? ii : 500 - ii));
+    }
+
+    Dict_Uninit(&dict_v_id_dst);
+    Dict_Uninit(&dict_v_id_src);
+
+    // three workers counting overlapping ranges of keys, as if each ran on its own thread
+    Dict_Partitioned(int, float) dict_v;
+    assert(Dict_InitPartitioned(&dict_v, 3, 5, 0));
+    assert(dict_v.partition_count == 8);
+
+    for (size_t worker = 0; worker < 3; worker++) {
+        for (int ii = (int)worker * 1000; ii < (int)worker * 1000 + 2000; ii++) {
+            bool   inserted_v;
+            float* count_v = Dict_Upsert(&dict_v, worker, ii, &inserted_v);
+            assert(count_v != NULL && inserted_v && *count_v == 0.0f);
+            *count_v += 1.0f;
+        }
+    }
+
+    for (size_t partition = 0; partition < dict_v.partition_count; partition++) {
+        assert(Dict_MergePartition(&dict_v, partition, add_floats, NULL));
+        assert(dict_v.partition[partition].size > 0 && dict_v.partition[partition + 8].size == 0);
+    }
+
+    for (int ii = 0; ii < 5000; ii++) {
+        float out_val_v;
+        assert(Dict_Get(&dict_v, ii, &out_val_v) == (ii < 4000));
+        assert(ii >= 4000 || out_val_v == (ii < 1000 || ii >= 3000 ? 1.0f : 2.0f));
+    }
+
+    Dict_Uninit(&dict_v);
+
     printf("All tests passed\n");
     return 0;
 }
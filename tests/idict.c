@@ -0,0 +1,142 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "containers/idict.h"
+
+typedef struct {
+    uint64_t   id;
+    IDict_Link by_id;
+    char*      name;
+    IDict_Link by_name;
+    char       payload[160];
+} record;
+
+#define IDict_Type      record
+#define IDict_KeyType   uint64_t
+#define IDict_KeyField  id
+#define IDict_LinkField by_id
+#include "containers/idict.h"
+
+// a second index over the same records, with its own link
+typedef record record_by_name;
+
+#define IDict_Type       record
+#define IDict_Type_Alias record_by_name
+#define IDict_KeyType    char*
+#define IDict_KeyField   name
+#define IDict_LinkField  by_name
+#include "containers/idict.h"
+
+typedef struct {
+    int x, y;
+} point;
+
+typedef struct {
+    point      key;
+    IDict_Link link;
+} point_entry;
+
+#define IDict_Type             point_entry
+#define IDict_KeyType          point
+#define IDict_KeyField         key
+#define IDict_LinkField        link
+#define IDict_HashKey(key)     (key.x + key.y)
+#define IDict_CompareKey(a, b) (a.x == b.x && a.y == b.y)
+#include "containers/idict.h"
+
+int main(void) {
+    /* --- Test A, Basic Insert/Find/Remove --- */
+    record*        records = calloc(10000, sizeof(record));
+    IDict(record)* by_id   = IDict_New(record)(0);
+
+    for (int ii = 0; ii < 10000; ii++) {
+        records[ii].id = ii * 7;
+        snprintf(records[ii].payload, sizeof(records[ii].payload), "record %d", ii);
+        assert(IDict_Insert(by_id, &records[ii]) == &records[ii]);
+    }
+    assert(by_id->size == 10000);
+
+    // the pointers found are the records themselves, however many times the table grew
+    for (int ii = 0; ii < 10000; ii++) {
+        assert(IDict_Find(by_id, ii * 7) == &records[ii]);
+        assert(IDict_Find(by_id, ii * 7 + 1) == NULL);
+    }
+
+    // a second record with a key that's already in the dict is left out
+    record dup = {.id = 7};
+    assert(IDict_Insert(by_id, &dup) == &records[1]);
+    assert(by_id->size == 10000);
+
+    for (int ii = 0; ii < 10000; ii += 2) {
+        assert(IDict_Remove(by_id, ii * 7) == &records[ii]);
+    }
+    assert(IDict_Remove(by_id, 0) == NULL);
+    for (int ii = 0; ii < 10000; ii++) {
+        assert(IDict_Find(by_id, ii * 7) == (ii % 2 ? &records[ii] : NULL));
+    }
+    assert(by_id->size == 5000);
+
+    // steady state churn shouldn't grow the dict
+    size_t capacity = by_id->capacity;
+    for (int ii = 0; ii < 100000; ii++) {
+        record* rec = &records[(ii % 5000) * 2];
+        assert(IDict_Insert(by_id, rec) == rec);
+        assert(IDict_Unlink(by_id, rec));
+    }
+    assert(by_id->capacity == capacity && by_id->size == 5000);
+    assert(!IDict_Unlink(by_id, &records[0]));
+
+    /* --- Test B, Two indexes over the same records --- */
+    IDict(record_by_name) by_name;
+    assert(IDict_Init(&by_name, 0));
+
+    char names[1000][16];
+    for (int ii = 0; ii < 1000; ii++) {
+        snprintf(names[ii], sizeof(names[ii]), "name %d", ii);
+        records[ii].name = names[ii];
+        assert(IDict_Insert(&by_name, &records[ii]) == &records[ii]);
+    }
+
+    char tmp[16];
+    for (int ii = 0; ii < 1000; ii++) {
+        snprintf(tmp, sizeof(tmp), "name %d", ii);
+        assert(IDict_Find(&by_name, tmp) == &records[ii]);
+        // the other index's link is untouched
+        assert(IDict_Find(by_id, records[ii].id) == (ii % 2 ? &records[ii] : NULL));
+    }
+
+    /* --- Test C, Iteration and custom keys --- */
+    size_t visited = 0;
+    IDict_ForEach(by_id, rec) {
+        assert(rec->id % 14 == 7);
+        visited += 1;
+    }
+    assert(visited == 5000);
+
+    // x + y only has 63 distinct values here, keys with the same sum share a tag and probe sequence
+    point_entry* points = calloc(32 * 32, sizeof(point_entry));
+    IDict(point_entry) by_point;
+    assert(IDict_Init(&by_point, 0));
+    for (int x = 0; x < 32; x++) {
+        for (int y = 0; y < 32; y++) {
+            points[x * 32 + y].key = (point){x, y};
+            assert(IDict_Insert(&by_point, &points[x * 32 + y]) == &points[x * 32 + y]);
+        }
+    }
+    assert(by_point.size == 1024);
+    assert(IDict_Find(&by_point, (point){31, 2}) == &points[31 * 32 + 2]);
+    assert(IDict_Find(&by_point, (point){32, 1}) == NULL);
+
+    IDict_Uninit(&by_point);
+    IDict_Uninit(&by_name);
+    IDict_Delete(by_id);
+    free(points);
+    free(records);
+
+    printf("All tests passed\n");
+    return 0;
+}
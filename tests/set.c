@@ -0,0 +1,207 @@
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define Set_KeyType int
+#include "containers/set.h"
+
+#define Set_KeyType       char*
+#define Set_KeyType_Alias str
+#include "containers/set.h"
+
+#define Set_KeyType uint8_t
+#include "containers/set.h"
+
+typedef struct {
+    int x, y;
+} foo;
+
+#define Set_KeyType            foo
+#define Set_HashKey(key)       (key.x + key.y)
+#define Set_CompareKey(k1, k2) (k1.x == k2.x && k1.y == k2.y)
+#include "containers/set.h"
+
+// the set has exactly the keys in [begin, end) that are multiples of step
+static bool has_range(Set(int) * set, int begin, int end, int step) {
+    size_t count = 0;
+    for (int ii = begin; ii < end; ii++) {
+        if (Set_Contains(set, ii) != (ii % step == 0)) {
+            return false;
+        }
+        count += ii % step == 0;
+    }
+
+    return set->size == count;
+}
+
+int main(void) {
+    /* --- Test A, Basic Insert/Contains/Remove --- */
+    Set(int)* set_a = Set_New(int)(0);
+
+    for (int ii = 0; ii < 10000; ii++) {
+        assert(Set_Insert(set_a, ii));
+    }
+    // inserting a key that's already there doesn't add it again
+    assert(Set_Insert(set_a, 42));
+    assert(set_a->size == 10000);
+
+    for (int ii = 0; ii < 10000; ii += 2) {
+        assert(Set_Remove(set_a, ii));
+    }
+    assert(!Set_Remove(set_a, 0));
+    for (int ii = 0; ii < 10000; ii++) {
+        assert(Set_Contains(set_a, ii) == (ii % 2 == 1));
+    }
+    assert(set_a->size == 5000);
+
+    // steady state churn shouldn't grow the set
+    size_t capacity = set_a->capacity;
+    for (int ii = 0; ii < 100000; ii++) {
+        assert(Set_Insert(set_a, 20000 + ii));
+        assert(Set_Remove(set_a, 20000 + ii));
+    }
+    assert(set_a->capacity == capacity && set_a->size == 5000);
+
+    Set_Clear(set_a);
+    assert(set_a->size == 0 && !Set_Contains(set_a, 1));
+    Set_Delete(set_a);
+
+    /* --- Test B, String and custom keys --- */
+    Set(str) set_b;
+    assert(Set_Init(&set_b, 0));
+
+    char keys[1000][16];
+    for (int ii = 0; ii < 1000; ii++) {
+        snprintf(keys[ii], sizeof(keys[ii]), "%d", ii);
+        assert(Set_Insert(&set_b, keys[ii]));
+    }
+
+    char tmp[16];
+    for (int ii = 0; ii < 2000; ii++) {
+        snprintf(tmp, sizeof(tmp), "%d", ii);
+        assert(Set_Contains(&set_b, tmp) == (ii < 1000));
+    }
+    Set_Uninit(&set_b);
+
+    // x + y only has 63 distinct values here, keys with the same sum share a tag and probe sequence
+    Set(foo) set_foo;
+    assert(Set_Init(&set_foo, 0));
+    for (int x = 0; x < 32; x++) {
+        for (int y = 0; y < 32; y++) {
+            assert(Set_Insert(&set_foo, (foo){x, y}));
+        }
+    }
+    assert(set_foo.size == 1024 && Set_Contains(&set_foo, (foo){31, 0}) && !Set_Contains(&set_foo, (foo){32, 0}));
+    Set_Uninit(&set_foo);
+
+    /* --- Test C, Iteration --- */
+    Set(int) set_c;
+    assert(Set_Init(&set_c, 0));
+    for (int ii = 0; ii < 1000; ii++) {
+        assert(Set_Insert(&set_c, ii * 3));
+    }
+
+    long sum = 0;
+    Set_ForEach(&set_c, key) {
+        sum += *key;
+    }
+    assert(sum == 3L * 999 * 1000 / 2);
+
+    // the loop variable can have any name, not just the iterator's member name
+    sum = 0;
+    Set_ForEach(&set_c, elem) {
+        sum += *elem;
+    }
+    assert(sum == 3L * 999 * 1000 / 2);
+
+    // break leaves the loop, continue moves on to the next key
+    size_t visited = 0;
+    Set_ForEach(&set_c, key) {
+        if (*key % 2 == 0) {
+            continue;
+        }
+        if (++visited == 10) {
+            break;
+        }
+    }
+    assert(visited == 10);
+
+    // 8-bit keys are matched a group at a time, a removed key's slot keeps its stale copy of the key
+    Set(uint8_t) set_u8;
+    assert(Set_Init(&set_u8, 0));
+    for (int ii = 0; ii < 256; ii++) {
+        assert(Set_Insert(&set_u8, (uint8_t)ii));
+    }
+    for (int ii = 1; ii < 256; ii += 2) {
+        assert(Set_Remove(&set_u8, (uint8_t)ii));
+    }
+    for (int ii = 0; ii < 256; ii++) {
+        assert(Set_Contains(&set_u8, (uint8_t)ii) == (ii % 2 == 0));
+    }
+    assert(set_u8.size == 128);
+    Set_Uninit(&set_u8);
+
+    /* --- Test D, Set algebra --- */
+    // multiples of 2 below 20000 and multiples of 3 below 6000, the sets have different seeds
+    Set(int) evens, threes, result;
+    assert(Set_Init(&evens, 0));
+    assert(Set_InitWithSeed(&threes, 0, 12345));
+    assert(Set_Init(&result, 0));
+    for (int ii = 0; ii < 20000; ii += 2) {
+        assert(Set_Insert(&evens, ii));
+    }
+    for (int ii = 0; ii < 6000; ii += 3) {
+        assert(Set_Insert(&threes, ii));
+    }
+
+    assert(Set_Intersect(&result, &evens, &threes));
+    assert(result.size == 1000);
+    for (int ii = 0; ii < 20000; ii++) {
+        assert(Set_Contains(&result, ii) == (ii % 6 == 0 && ii < 6000));
+    }
+
+    // intersecting is symmetric, the smaller set is visited either way
+    assert(Set_Intersect(&result, &threes, &evens));
+    assert(result.size == 1000);
+
+    assert(Set_Union(&result, &threes, &evens));
+    assert(result.size == 10000 + 2000 - 1000);
+    // the copy of the larger set is grown once, for both sets' keys
+    assert(result.capacity == Set_CapacityFor(&result, 10000 + 2000));
+    for (int ii = 0; ii < 20000; ii++) {
+        assert(Set_Contains(&result, ii) == (ii % 2 == 0 || (ii % 3 == 0 && ii < 6000)));
+    }
+
+    // both sides of a difference, the smaller set probed for in the larger one and the larger one's copy having
+    // the smaller set's keys removed
+    assert(Set_Difference(&result, &threes, &evens));
+    assert(result.size == 1000);
+    for (int ii = 0; ii < 6000; ii++) {
+        assert(Set_Contains(&result, ii) == (ii % 3 == 0 && ii % 2 != 0));
+    }
+
+    assert(Set_Difference(&result, &evens, &threes));
+    assert(result.size == 9000);
+    for (int ii = 0; ii < 20000; ii++) {
+        assert(Set_Contains(&result, ii) == (ii % 2 == 0 && (ii % 3 != 0 || ii >= 6000)));
+    }
+
+    // the result can replace one of the operands
+    assert(Set_Difference(&evens, &evens, &evens));
+    assert(evens.size == 0);
+    assert(Set_Union(&evens, &evens, &threes));
+    assert(has_range(&evens, 0, 6000, 3));
+    assert(Set_Intersect(&threes, &threes, &result));
+    assert(threes.size == 0);
+
+    Set_Uninit(&evens);
+    Set_Uninit(&threes);
+    Set_Uninit(&result);
+    Set_Uninit(&set_c);
+
+    printf("All tests passed\n");
+    return 0;
+}